@@ -0,0 +1,373 @@
+#pragma once
+
+#include <vector>
+#include <atomic>
+#include <thread>
+#include <chrono>
+#include <string>
+#include <cstdint>
+#include <cstddef>
+#include <algorithm>
+#include <functional>
+#include <ostream>
+#include <sstream>
+#include <type_traits>
+#include <utility>
+
+#include "lfq_stats.h"
+
+#if defined(_WIN32)
+#include <windows.h>
+#elif defined(__linux__)
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+// 基准测试公共设施：负载类型、线程绑核、计时与结果输出
+// 所有队列引擎共享同一套测量流程，保证结果可比
+namespace lfq_bench {
+
+// 单次测试的参数
+struct bench_config {
+	std::string engine;			// 队列引擎名称
+	std::string payload;		// 负载类型名称
+	size_t producers = 1;		// 生产者线程数
+	size_t consumers = 1;		// 消费者线程数
+	size_t capacity = 1024;		// 队列容量
+	size_t ops_per_producer = 200000;	// 每个生产者写入的元素个数
+	size_t sample_every = 16;	// 每隔多少个元素采样一次延迟
+	size_t batch = 1;			// 批量大小（队列支持 enqueue_bulk/dequeue_bulk 时生效）
+	bool pin = true;			// 是否绑核
+};
+
+// 单次测试的结果
+struct bench_result {
+	bench_config config;
+	double seconds = 0;			// 总耗时
+	double mops = 0;			// 吞吐量（百万次出队/秒）
+	double p50_ns = 0;			// 入队到出队延迟分位数
+	double p99_ns = 0;
+	double p999_ns = 0;
+	size_t samples = 0;			// 延迟样本数
+	bool skipped = false;		// 批量大于队列实际可用容量，未运行
+	bool has_cas_retries = false;	// 队列打开了统计，cas_retries 有效
+	uint64_t cas_retries = 0;	// head/tail 的 CAS 重试次数（队列打开统计时才有）
+};
+
+// 进程内单调时钟（纳秒），以首次调用为零点
+inline uint64_t now_ns() {
+	static const auto origin = std::chrono::steady_clock::now();
+	return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+		std::chrono::steady_clock::now() - origin).count());
+}
+
+// 固定大小的负载，首8字节存放入队时间戳
+template <size_t Size>
+struct payload_bytes {
+	static_assert(Size >= sizeof(uint64_t), "Payload must be able to hold a timestamp.");
+	uint64_t stamp = 0;
+	unsigned char pad[Size - sizeof(uint64_t)] = {};
+};
+
+// 负载的时间戳读写方式
+template <typename P>
+struct payload_traits {
+	static P make(uint64_t stamp) {
+		P p;
+		p.stamp = stamp;
+		return p;
+	}
+	static uint64_t latency(const P& p, uint64_t now) {
+		return now - p.stamp;
+	}
+};
+
+// int 负载只能存放32位，按纳秒截断后做模2^32差值，延迟不超过4秒即正确
+template <>
+struct payload_traits<int> {
+	static int make(uint64_t stamp) {
+		return static_cast<int>(static_cast<uint32_t>(stamp));
+	}
+	static uint64_t latency(int p, uint64_t now) {
+		return static_cast<uint32_t>(static_cast<uint32_t>(now) - static_cast<uint32_t>(p));
+	}
+};
+
+// 将当前线程绑定到指定CPU（按在线CPU数取模）
+inline void pin_thread(size_t index) {
+	size_t const cpus = std::max<size_t>(1, std::thread::hardware_concurrency());
+	size_t const cpu = index % cpus;
+#if defined(_WIN32)
+	SetThreadAffinityMask(GetCurrentThread(), DWORD_PTR(1) << cpu);
+#elif defined(__linux__)
+	cpu_set_t set;
+	CPU_ZERO(&set);
+	CPU_SET(cpu, &set);
+	pthread_setaffinity_np(pthread_self(), sizeof(set), &set);
+#else
+	(void)cpu;
+#endif
+}
+
+// 失败重试时的让步：先短暂自旋，再让出CPU
+inline void retry_pause(unsigned& spins) {
+	if (++spins < 64) {
+		std::atomic_signal_fence(std::memory_order_seq_cst);
+	}
+	else {
+		spins = 0;
+		std::this_thread::yield();
+	}
+}
+
+// 检测队列是否提供批量接口
+template <typename Queue, typename P, typename = void>
+struct has_bulk : std::false_type {};
+
+template <typename Queue, typename P>
+struct has_bulk<Queue, P, std::void_t<
+	decltype(std::declval<Queue&>().enqueue_bulk(std::declval<P*>(), size_t(1))),
+	decltype(std::declval<Queue&>().dequeue_bulk(std::declval<P*>(), size_t(1)))>> : std::true_type {};
+
+// 检测队列是否提供统计
+template <typename Queue, typename = void>
+struct has_stats : std::false_type {};
+
+template <typename Queue>
+struct has_stats<Queue, std::void_t<decltype(std::declval<const Queue&>().stats()[lfq_stat::cas_retry])>> : std::true_type {};
+
+// 对单个队列类型运行一次测试
+// Queue 需提供 Queue(size_t)、enqueue(T&&)、dequeue(T&)
+// cfg.batch > 1 且 Queue 提供 enqueue_bulk/dequeue_bulk 时按批量收发
+template <typename Queue, typename P>
+bench_result run_case(const bench_config& cfg_in) {
+	bench_config cfg = cfg_in;
+	if (!has_bulk<Queue, P>::value)
+		cfg.batch = 1;
+	Queue queue(cfg.capacity);
+
+	// enqueue_bulk 要么全部写入要么失败：批量超过实际可用容量（取模模式少一个）时永远写不进去
+	if constexpr (has_bulk<Queue, P>::value) {
+		if (cfg.batch > queue.capacity()) {
+			bench_result r;
+			r.config = cfg;
+			r.skipped = true;
+			return r;
+		}
+	}
+
+	size_t const total = cfg.producers * cfg.ops_per_producer;
+	size_t const threads = cfg.producers + cfg.consumers;
+
+	std::atomic<size_t> ready{ 0 };
+	std::atomic<bool> go{ false };
+	std::atomic<size_t> consumed{ 0 };
+	std::vector<std::vector<uint64_t>> samples(cfg.consumers);
+	std::vector<std::thread> workers;
+	workers.reserve(threads);
+
+	auto wait_start = [&](size_t index) {
+		if (cfg.pin)
+			pin_thread(index);
+		ready.fetch_add(1, std::memory_order_acq_rel);
+		while (!go.load(std::memory_order_acquire))
+			std::this_thread::yield();
+	};
+
+	// 消费者占用前几个CPU，生产者依次排在后面
+	for (size_t c = 0; c < cfg.consumers; ++c) {
+		workers.emplace_back([&, c] {
+			std::vector<uint64_t>& local = samples[c];
+			local.reserve(total / cfg.sample_every / cfg.consumers + 16);
+			wait_start(c);
+
+			size_t count = 0;
+			unsigned spins = 0;
+			std::vector<P> items(cfg.batch);
+			for (;;) {
+				if (cfg.consumers == 1) {
+					if (count == total)
+						break;
+				}
+				else if (consumed.load(std::memory_order_relaxed) >= total) {
+					break;
+				}
+
+				size_t got = 0;
+				if constexpr (has_bulk<Queue, P>::value) {
+					if (cfg.batch > 1)
+						got = queue.dequeue_bulk(items.data(), cfg.batch);
+					else
+						got = queue.dequeue(items[0]) ? 1 : 0;
+				}
+				else {
+					got = queue.dequeue(items[0]) ? 1 : 0;
+				}
+				if (got == 0) {
+					retry_pause(spins);
+					continue;
+				}
+
+				uint64_t const now = now_ns();
+				for (size_t k = 0; k < got; ++k, ++count)
+					if (count % cfg.sample_every == 0)
+						local.push_back(payload_traits<P>::latency(items[k], now));
+				if (cfg.consumers > 1)
+					consumed.fetch_add(got, std::memory_order_relaxed);
+			}
+			});
+	}
+
+	for (size_t p = 0; p < cfg.producers; ++p) {
+		workers.emplace_back([&, p] {
+			wait_start(cfg.consumers + p);
+
+			unsigned spins = 0;
+			if constexpr (has_bulk<Queue, P>::value) {
+				if (cfg.batch > 1) {
+					std::vector<P> items(cfg.batch);
+					for (size_t i = 0; i < cfg.ops_per_producer; i += cfg.batch) {
+						size_t const n = std::min(cfg.batch, cfg.ops_per_producer - i);
+						uint64_t const stamp = now_ns();
+						for (size_t k = 0; k < n; ++k)
+							items[k] = payload_traits<P>::make(stamp);
+						while (!queue.enqueue_bulk(items.data(), n))
+							retry_pause(spins);
+					}
+					return;
+				}
+			}
+			for (size_t i = 0; i < cfg.ops_per_producer; ++i) {
+				P item = payload_traits<P>::make(now_ns());
+				while (!queue.enqueue(std::move(item)))
+					retry_pause(spins);
+			}
+			});
+	}
+
+	while (ready.load(std::memory_order_acquire) != threads)
+		std::this_thread::yield();
+
+	auto const begin = std::chrono::steady_clock::now();
+	go.store(true, std::memory_order_release);
+	for (auto& w : workers)
+		w.join();
+	auto const end = std::chrono::steady_clock::now();
+
+	std::vector<uint64_t> all;
+	for (auto& s : samples)
+		all.insert(all.end(), s.begin(), s.end());
+	std::sort(all.begin(), all.end());
+
+	auto percentile = [&](double q) -> double {
+		if (all.empty())
+			return 0;
+		size_t idx = static_cast<size_t>(q * static_cast<double>(all.size() - 1));
+		return static_cast<double>(all[idx]);
+	};
+
+	bench_result r;
+	r.config = cfg;
+	r.seconds = std::chrono::duration<double>(end - begin).count();
+	r.mops = r.seconds > 0 ? static_cast<double>(total) / r.seconds / 1e6 : 0;
+	r.p50_ns = percentile(0.50);
+	r.p99_ns = percentile(0.99);
+	r.p999_ns = percentile(0.999);
+	r.samples = all.size();
+	if constexpr (has_stats<Queue>::value) {
+		if constexpr (Queue::stats_type::enabled) {
+			r.has_cas_retries = true;
+			r.cas_retries = queue.stats()[lfq_stat::cas_retry];
+		}
+	}
+	return r;
+}
+
+// 已注册的队列引擎：按负载名分派到具体的模板实例
+struct bench_engine {
+	std::string name;
+	bool multi_consumer = false;	// 是否支持多消费者
+	bool multi_producer = true;		// 是否支持多生产者
+	bool bulk = false;				// 是否提供 enqueue_bulk/dequeue_bulk，不支持时跳过 batch > 1 的组合
+	std::function<bool(const bench_config&, bench_result&)> run;
+};
+
+template <template <typename> class Queue>
+bench_engine make_engine(std::string name, bool multi_consumer, bool multi_producer = true) {
+	bench_engine e;
+	e.name = std::move(name);
+	e.multi_consumer = multi_consumer;
+	e.multi_producer = multi_producer;
+	e.bulk = has_bulk<Queue<int>, int>::value;
+	e.run = [](const bench_config& cfg, bench_result& out) {
+		if (cfg.payload == "int")
+			out = run_case<Queue<int>, int>(cfg);
+		else if (cfg.payload == "64")
+			out = run_case<Queue<payload_bytes<64>>, payload_bytes<64>>(cfg);
+		else if (cfg.payload == "256")
+			out = run_case<Queue<payload_bytes<256>>, payload_bytes<256>>(cfg);
+		else
+			return false;
+		return true;
+	};
+	return e;
+}
+
+// 结果输出
+inline void write_csv_header(std::ostream& os) {
+	os << "engine,payload,producers,consumers,capacity,batch,ops,seconds,mops,p50_ns,p99_ns,p999_ns,cas_retries\n";
+}
+
+inline void write_csv_row(std::ostream& os, const bench_result& r) {
+	const bench_config& c = r.config;
+	os << c.engine << ',' << c.payload << ',' << c.producers << ',' << c.consumers << ','
+		<< c.capacity << ',' << c.batch << ',' << c.producers * c.ops_per_producer << ','
+		<< r.seconds << ',' << r.mops << ','
+		<< r.p50_ns << ',' << r.p99_ns << ',' << r.p999_ns << ',';
+	// 没有统计时留空，与真实的0次重试区分
+	if (r.has_cas_retries)
+		os << r.cas_retries;
+	os << '\n';
+}
+
+inline void write_json(std::ostream& os, const std::vector<bench_result>& results) {
+	os << "[\n";
+	for (size_t i = 0; i < results.size(); ++i) {
+		const bench_result& r = results[i];
+		const bench_config& c = r.config;
+		os << "  {\"engine\": \"" << c.engine << "\", \"payload\": \"" << c.payload
+			<< "\", \"producers\": " << c.producers << ", \"consumers\": " << c.consumers
+			<< ", \"capacity\": " << c.capacity << ", \"batch\": " << c.batch << ", \"ops\": " << c.producers * c.ops_per_producer
+			<< ", \"seconds\": " << r.seconds << ", \"mops\": " << r.mops
+			<< ", \"p50_ns\": " << r.p50_ns << ", \"p99_ns\": " << r.p99_ns
+			<< ", \"p999_ns\": " << r.p999_ns << ", \"samples\": " << r.samples
+			<< ", \"cas_retries\": ";
+		if (r.has_cas_retries)
+			os << r.cas_retries;
+		else
+			os << "null";
+		os << "}"
+			<< (i + 1 < results.size() ? ",\n" : "\n");
+	}
+	os << "]\n";
+}
+
+// 解析逗号分隔的列表
+inline std::vector<std::string> split_list(const std::string& s) {
+	std::vector<std::string> out;
+	std::stringstream ss(s);
+	std::string item;
+	while (std::getline(ss, item, ','))
+		if (!item.empty())
+			out.push_back(item);
+	return out;
+}
+
+inline std::vector<size_t> split_sizes(const std::string& s) {
+	std::vector<size_t> out;
+	for (const auto& item : split_list(s))
+		out.push_back(static_cast<size_t>(std::stoull(item)));
+	return out;
+}
+
+} // namespace lfq_bench
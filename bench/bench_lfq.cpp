@@ -0,0 +1,252 @@
+#include <iostream>
+#include <fstream>
+#include <string>
+#include <vector>
+#include <thread>
+#include <algorithm>
+
+#include <lfq_array_based.h>
+#include <lfq_array_seq.h>
+#include <lfq_array_faa.h>
+#include <lfq_spsc.h>
+#include <lfq_unbounded.h>
+#include <lfq_linked.h>
+#include <lfq_sharded.h>
+
+#include "bench_common.h"
+
+using namespace std;
+using namespace lfq_bench;
+
+// 用法：
+//   bench_lfq [--engines=a,b] [--producers=1,2,4] [--consumers=1,2]
+//             [--capacities=1024,65536] [--payloads=int,64,256]
+//             [--ops=N] [--batch=1,32] [--sample=N] [--format=csv|json] [--out=FILE] [--no-pin] [--list]
+// --ops 为每个生产者的元素数；不支持多消费者/多生产者的引擎只运行单消费者/单生产者配置
+// --batch 大于1时使用 enqueue_bulk/dequeue_bulk，不支持批量接口的引擎跳过
+
+// 2的幂容量 + 掩码索引
+template <typename T>
+using lfq_array_pow2 = lfq_array_based<T, lfq_pow2_traits>;
+
+// 多消费者模式
+template <typename T>
+using lfq_array_mpmc = lfq_array_based<T, lfq_mpmc_traits>;
+
+// 槽位布局：填充到64/128字节、连续序号分散到不同缓存行
+struct pad64_traits : lfq_pow2_traits {
+	using slot_layout = lfq_padded_layout<64>;
+};
+struct pad128_traits : lfq_pow2_traits {
+	using slot_layout = lfq_padded_layout<128>;
+};
+struct remap_traits : lfq_pow2_traits {
+	using slot_layout = lfq_remap_layout;
+};
+
+// 关闭 head/tail 缓存，用于对比缓存带来的收益
+struct nocache_traits : lfq_pow2_traits {
+	static constexpr bool cache_indices = false;
+};
+
+// 生产者 CAS 失败后退避：指数退避 / 按线程最近失败情况自适应
+struct expbackoff_traits : lfq_pow2_traits {
+	using backoff_policy = lfq_exp_backoff<>;
+};
+struct adaptive_traits : lfq_pow2_traits {
+	using backoff_policy = lfq_adaptive_backoff<>;
+};
+
+// 消费者每取32个元素才发布一次 head
+struct batchhead_traits : lfq_pow2_traits {
+	static constexpr size_t head_publish_interval = 32;
+};
+
+// 2MB 大页缓冲区（大容量时减少 TLB 缺失）
+struct huge_traits : lfq_pow2_traits {
+	using allocator = lfq_hugepage_allocator;
+};
+
+template <typename T>
+using lfq_array_nocache = lfq_array_based<T, nocache_traits>;
+template <typename T>
+using lfq_array_pad64 = lfq_array_based<T, pad64_traits>;
+template <typename T>
+using lfq_array_pad128 = lfq_array_based<T, pad128_traits>;
+template <typename T>
+using lfq_array_remap = lfq_array_based<T, remap_traits>;
+template <typename T>
+using lfq_array_huge = lfq_array_based<T, huge_traits>;
+template <typename T>
+using lfq_array_batchhead = lfq_array_based<T, batchhead_traits>;
+template <typename T>
+using lfq_array_expbackoff = lfq_array_based<T, expbackoff_traits>;
+template <typename T>
+using lfq_array_adaptive = lfq_array_based<T, adaptive_traits>;
+
+template <typename T>
+using lfq_spsc_pow2 = lfq_spsc<T, lfq_pow2_traits>;
+
+// 无界分段队列：容量参数只作为预分配大小
+template <typename T>
+using lfq_unbounded_mpsc = lfq_unbounded<T>;
+template <typename T>
+using lfq_unbounded_mpmc = lfq_unbounded<T, 1024, lfq_mpmc_traits>;
+
+// 分片 MPSC：容量为每个分片的容量，生产者由 thread_local 自动认领分片
+template <typename T>
+using lfq_sharded_pow2 = lfq_sharded<T, lfq_pow2_traits>;
+
+// 注册全部队列引擎
+static vector<bench_engine> all_engines() {
+	vector<bench_engine> engines;
+	engines.push_back(make_engine<lfq_array_based>("array_based", false));
+	engines.push_back(make_engine<lfq_array_pow2>("array_pow2", false));
+	engines.push_back(make_engine<lfq_array_nocache>("array_nocache", false));
+	engines.push_back(make_engine<lfq_array_pad64>("array_pad64", false));
+	engines.push_back(make_engine<lfq_array_pad128>("array_pad128", false));
+	engines.push_back(make_engine<lfq_array_remap>("array_remap", false));
+	engines.push_back(make_engine<lfq_array_huge>("array_huge", false));
+	engines.push_back(make_engine<lfq_array_batchhead>("array_batchhead", false));
+	engines.push_back(make_engine<lfq_array_expbackoff>("array_expbackoff", false));
+	engines.push_back(make_engine<lfq_array_adaptive>("array_adaptive", false));
+	engines.push_back(make_engine<lfq_array_mpmc>("array_mpmc", true));
+	engines.push_back(make_engine<lfq_array_seq>("array_seq", true));
+	engines.push_back(make_engine<lfq_array_faa>("array_faa", true));
+	engines.push_back(make_engine<lfq_spsc_pow2>("spsc", false, false));
+	engines.push_back(make_engine<lfq_unbounded_mpsc>("unbounded", false));
+	engines.push_back(make_engine<lfq_unbounded_mpmc>("unbounded_mpmc", true));
+	engines.push_back(make_engine<lfq_linked>("linked", true));
+	engines.push_back(make_engine<lfq_sharded_pow2>("sharded", false));
+	return engines;
+}
+
+// 默认生产者数：1, 2, 4 ... 直到CPU核数
+static vector<size_t> default_producers() {
+	size_t const cores = max<size_t>(1, thread::hardware_concurrency());
+	vector<size_t> out;
+	for (size_t n = 1; n < cores; n *= 2)
+		out.push_back(n);
+	out.push_back(cores);
+	return out;
+}
+
+static bool starts_with(const string& s, const string& prefix, string& rest) {
+	if (s.compare(0, prefix.size(), prefix) != 0)
+		return false;
+	rest = s.substr(prefix.size());
+	return true;
+}
+
+int main(int argc, char** argv) {
+	vector<bench_engine> engines = all_engines();
+
+	vector<string> engine_names;
+	vector<size_t> producers = default_producers();
+	vector<size_t> consumers = { 1 };
+	vector<size_t> batches = { 1 };
+	vector<size_t> capacities = { 1024, 65536 };
+	vector<string> payloads = { "int", "64", "256" };
+	size_t ops = 200000;
+	size_t sample_every = 16;
+	string format = "csv";
+	string out_path;
+	bool pin = true;
+
+	for (int i = 1; i < argc; ++i) {
+		string arg = argv[i], v;
+		if (starts_with(arg, "--engines=", v)) engine_names = split_list(v);
+		else if (starts_with(arg, "--producers=", v)) producers = split_sizes(v);
+		else if (starts_with(arg, "--consumers=", v)) consumers = split_sizes(v);
+		else if (starts_with(arg, "--capacities=", v)) capacities = split_sizes(v);
+		else if (starts_with(arg, "--payloads=", v)) payloads = split_list(v);
+		else if (starts_with(arg, "--ops=", v)) ops = stoull(v);
+		else if (starts_with(arg, "--batch=", v)) batches = split_sizes(v);
+		else if (starts_with(arg, "--sample=", v)) sample_every = max<size_t>(1, stoull(v));
+		else if (starts_with(arg, "--format=", v)) format = v;
+		else if (starts_with(arg, "--out=", v)) out_path = v;
+		else if (arg == "--no-pin") pin = false;
+		else if (arg == "--list") {
+			for (const auto& e : engines)
+				cout << e.name << (!e.multi_producer ? " (spsc)" : e.multi_consumer ? " (mpmc)" : "") << "\n";
+			return 0;
+		}
+		else {
+			cerr << "Unknown argument: " << arg << endl;
+			return 1;
+		}
+	}
+
+	if (format != "csv" && format != "json") {
+		cerr << "Unknown format: " << format << " (expected csv or json)" << endl;
+		return 1;
+	}
+
+	vector<bench_result> results;
+	ofstream file;
+	if (!out_path.empty()) {
+		file.open(out_path);
+		if (!file) {
+			cerr << "Cannot open " << out_path << endl;
+			return 1;
+		}
+	}
+	ostream& os = out_path.empty() ? cout : file;
+
+	if (format == "csv")
+		write_csv_header(os);
+
+	for (const auto& engine : engines) {
+		if (!engine_names.empty() &&
+			find(engine_names.begin(), engine_names.end(), engine.name) == engine_names.end())
+			continue;
+
+		for (const auto& payload : payloads)
+			for (size_t capacity : capacities)
+				for (size_t c : consumers) {
+					if (c > 1 && !engine.multi_consumer)
+						continue;
+					for (size_t b : batches) {
+						// 引擎不支持批量接口：跳过，不运行
+						if (b > 1 && !engine.bulk)
+							continue;
+						for (size_t p : producers) {
+							if (p > 1 && !engine.multi_producer)
+								continue;
+							bench_config cfg;
+							cfg.engine = engine.name;
+							cfg.payload = payload;
+							cfg.producers = p;
+							cfg.consumers = c;
+							cfg.capacity = capacity;
+							cfg.ops_per_producer = ops;
+							cfg.sample_every = sample_every;
+							cfg.batch = max<size_t>(1, b);
+							cfg.pin = pin;
+
+							bench_result r;
+							if (!engine.run(cfg, r)) {
+								cerr << "Unknown payload: " << payload << endl;
+								return 1;
+							}
+							if (r.skipped) {
+								cerr << "Skipping " << engine.name << " payload=" << payload << " cap=" << capacity
+									<< ": batch " << cfg.batch << " exceeds usable capacity" << endl;
+								continue;
+							}
+							if (format == "csv")
+								write_csv_row(os, r);
+							else
+								cerr << engine.name << " payload=" << payload << " p=" << p
+									<< " c=" << c << " cap=" << capacity << " batch=" << cfg.batch
+									<< " " << r.mops << " Mops/s" << endl;
+							results.push_back(r);
+						}
+					}
+				}
+	}
+
+	if (format == "json")
+		write_json(os, results);
+	return 0;
+}
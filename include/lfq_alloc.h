@@ -0,0 +1,135 @@
+#pragma once
+
+#include <cerrno>
+#include <cstddef>
+#include <cstdint>
+#include <new>
+#include <stdexcept>
+#include <system_error>
+
+#if defined(__linux__)
+#include <linux/mempolicy.h>
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+// 缓冲区分配策略：Traits::allocator 选择，队列构造时可传入已配置好的分配器对象
+// 每个分配器提供
+//   void* allocate(size_t bytes, size_t align)        失败时抛出 std::bad_alloc
+//   void  deallocate(void* p, size_t bytes, size_t align) noexcept
+
+// 默认：对齐的 operator new
+struct lfq_new_allocator {
+	void* allocate(size_t bytes, size_t align) {
+		return ::operator new(bytes, std::align_val_t(align));
+	}
+
+	void deallocate(void* p, size_t, size_t align) noexcept {
+		::operator delete(p, std::align_val_t(align));
+	}
+};
+
+// 当前线程所在的 NUMA 节点（不支持时返回 -1），供消费者线程查询后传给 lfq_hugepage_allocator
+inline int lfq_current_numa_node() {
+#if defined(__linux__) && defined(SYS_getcpu)
+	unsigned cpu = 0;
+	unsigned node = 0;
+	if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+		return static_cast<int>(node);
+#endif
+	return -1;
+}
+
+// 大页 + NUMA 绑定（Linux）：
+//   按 2MB 对齐映射，madvise(MADV_HUGEPAGE) 使用透明大页；use_hugetlb 时先尝试 MAP_HUGETLB 预留大页，失败再退回透明大页
+//   numa_node >= 0 时在首次访问前用 mbind 把整段内存绑定到该节点，节点编号须小于 max_numa_node（否则抛出 std::invalid_argument）
+//   mbind 失败（节点不存在或不在线等）时解除映射并抛出 std::system_error；内核不支持 NUMA 时只接受节点0
+//   prefault 时在构造线程中逐页写入，避免运行期间缺页
+// 其他平台退化为 lfq_new_allocator
+struct lfq_hugepage_allocator {
+	static constexpr size_t huge_page_size = size_t(2) << 20;
+	static constexpr int max_numa_node = static_cast<int>(sizeof(unsigned long) * 8);	// mbind 节点掩码只有一个 unsigned long
+
+	int numa_node = -1;			// 绑定的 NUMA 节点，-1 不绑定
+	bool prefault = true;		// 构造时预先触发缺页
+	bool use_hugetlb = false;	// 优先使用预留的 hugetlbfs 大页
+
+	void* allocate(size_t bytes, size_t align) {
+		if (numa_node >= max_numa_node)
+			throw std::invalid_argument("NUMA node is out of range.");
+#if defined(__linux__)
+		if (align > huge_page_size)
+			throw std::bad_alloc();
+		size_t const length = round_up(bytes);
+		void* p = nullptr;
+
+		// 1. 预留大页（需要系统事先配置 vm.nr_hugepages）
+#if defined(MAP_HUGETLB)
+		if (use_hugetlb) {
+			p = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+			if (p == MAP_FAILED)
+				p = nullptr;
+		}
+#endif
+
+		// 2. 透明大页：多映射一个大页再裁掉首尾，得到 2MB 对齐的区间
+		if (!p) {
+			void* raw = mmap(nullptr, length + huge_page_size, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+			if (raw == MAP_FAILED)
+				throw std::bad_alloc();
+			uintptr_t const begin = reinterpret_cast<uintptr_t>(raw);
+			uintptr_t const aligned = (begin + huge_page_size - 1) & ~(uintptr_t(huge_page_size) - 1);
+			if (aligned > begin)
+				munmap(raw, aligned - begin);
+			size_t const tail = begin + length + huge_page_size - (aligned + length);
+			if (tail > 0)
+				munmap(reinterpret_cast<void*>(aligned + length), tail);
+			p = reinterpret_cast<void*>(aligned);
+#if defined(MADV_HUGEPAGE)
+			madvise(p, length, MADV_HUGEPAGE);
+#endif
+		}
+
+		// 3. 在首次访问前绑定节点，绑定失败则不交出这段内存
+#if defined(SYS_mbind)
+		if (numa_node >= 0) {
+			unsigned long mask = 1ul << numa_node;
+			// maxnode 按内核的约定多算一位（内核实际只读取 maxnode - 1 位）
+			if (syscall(SYS_mbind, p, length, MPOL_BIND, &mask, sizeof(mask) * 8 + 1, 0) != 0) {
+				int const err = errno;
+				// 内核未启用 NUMA：整机只有节点0，无需绑定
+				if (!(err == ENOSYS && numa_node == 0)) {
+					munmap(p, length);
+					throw std::system_error(err, std::generic_category(), "mbind");
+				}
+			}
+		}
+#endif
+
+		// 4. 逐页写入，触发缺页
+		if (prefault) {
+			volatile unsigned char* bytes_p = static_cast<volatile unsigned char*>(p);
+			for (size_t off = 0; off < length; off += 4096)
+				bytes_p[off] = 0;
+		}
+		return p;
+#else
+		return lfq_new_allocator().allocate(bytes, align);
+#endif
+	}
+
+	void deallocate(void* p, size_t bytes, size_t align) noexcept {
+#if defined(__linux__)
+		(void)align;
+		munmap(p, round_up(bytes));
+#else
+		lfq_new_allocator().deallocate(p, bytes, align);
+#endif
+	}
+
+private:
+	static size_t round_up(size_t bytes) {
+		return (bytes + huge_page_size - 1) & ~(huge_page_size - 1);
+	}
+};
@@ -1,208 +1,798 @@
 #pragma once
 
 #include <vector>
+#include <algorithm>
 #include <atomic>
 #include <memory>
+#include <cstdint>
 
 #include <stdexcept>
 #include <cassert>
 #include <iostream>
 
-template <typename T>
+#include "lfq_traits.h"
+#include "lfq_layout.h"
+#include "lfq_wait.h"
+#include "lfq_backoff.h"
+#include "lfq_storage.h"
+#include "lfq_stats.h"
+#include "lfq_latency.h"
+#include "lfq_alloc.h"
+
+// head_/tail_ 为单调递增的64位序号，由 Traits::index_policy 映射到槽位下标
+// 默认取模索引保留一个空槽；lfq_pow2_traits 将容量取整为2的幂并使用全部槽位
+// 默认单消费者（MPSC）；Traits::consumer_policy 为 lfq_multi_consumer 时支持多消费者（MPMC）
+// Traits::slot_layout 控制槽位填充与下标重排，用于消除相邻槽位的伪共享
+// Traits::wait_strategy 决定 enqueue_wait/dequeue_wait 在满/空时如何等待
+// Traits::backoff_policy 决定 head/tail 的 CAS 失败后如何退避，重试与让出时间片的次数计入统计
+// 槽位为未初始化存储：入队时原地构造，出队时析构，T 不必可默认构造
+// try_reserve/commit 与 peek/release 让大元素直接在队列内存中读写，省去入队/出队的拷贝
+// close() 之后拒绝新的入队，消费者取完剩余元素后 dequeue_wait 返回 false
+// Traits::stats_policy 为 lfq_thread_stats 时按线程统计失败原因与重试次数，stats() 汇总
+// Traits::latency_policy 为 lfq_sampled_latency 时采样元素在队列中的驻留时间，latency() 读取直方图
+// Traits::allocator 分配槽位缓冲区，可在构造时传入配置好的分配器（如大页、NUMA 节点）
+// Traits::head_publish_interval 大于1时单消费者攒够一批才发布一次 head_，减少对生产者缓存行的写入
+template <typename T, typename Traits = lfq_default_traits>
 class lfq_array_based {
 public:
-	explicit lfq_array_based(size_t capacity);
+	using index_type = typename Traits::index_policy;
+	using consumer_type = typename Traits::consumer_policy;
+	using layout_type = typename Traits::slot_layout;
+	using wait_type = typename Traits::wait_strategy;
+	using backoff_type = typename Traits::backoff_policy;
+	using backoff_state_type = typename backoff_type::state;
+	using stats_type = typename Traits::stats_policy;
+	using latency_type = typename Traits::latency_policy;
+	using allocator_type = typename Traits::allocator;
+
+	explicit lfq_array_based(size_t capacity, const allocator_type& alloc = allocator_type());
 
 	bool enqueue(const T& value);
 
 	bool enqueue(T&& value);
 
+	// 在槽位上原地构造元素
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
 	bool dequeue(T& value);
 
+	// 两阶段入队（零拷贝）：try_reserve 认领一个槽位并在其中构造元素，返回元素指针
+	// 调用方直接在队列内存中填写数据，再以 commit 发布；队列满时返回 nullptr
+	// 不带参数时对 T 做默认初始化（平凡类型不清零），析构队列前必须 commit 所有预留
+	template <typename... Args>
+	T* try_reserve(Args&&... args);
+
+	void commit(T* reserved);
+
+	// 两阶段出队（零拷贝，仅单消费者）：peek 返回队首已就绪元素的指针，队列空时返回 nullptr
+	// 处理完后调用 release 析构元素并归还槽位；两次调用之间元素保持在原处
+	T* peek();
+
+	void release();
+
+	// 批量入队：一次 CAS 预留连续的 n 个槽位，全部写入后发布
+	// 空间不足时不写入任何元素并返回 false
+	template <typename It>
+	bool enqueue_bulk(It first, size_t n);
+
+	// 批量出队：最多取出 max 个已就绪的连续元素写入 out，只更新一次 head
+	// 返回实际取出的个数
+	template <typename OutIt>
+	size_t dequeue_bulk(OutIt out, size_t max);
+
+	// 阻塞版本：队列满/空时按等待策略等待，超时返回 false
+	// 队列关闭后 enqueue_wait 立即返回 false，dequeue_wait 在队列取空后返回 false
+	template <typename Rep, typename Period>
+	bool enqueue_wait(const T& value, const std::chrono::duration<Rep, Period>& timeout);
+
+	template <typename Rep, typename Period>
+	bool enqueue_wait(T&& value, const std::chrono::duration<Rep, Period>& timeout);
+
+	template <typename Rep, typename Period>
+	bool dequeue_wait(T& value, const std::chrono::duration<Rep, Period>& timeout);
+
+	// 无超时：一直等待直到成功，只有队列关闭时返回 false
+	bool enqueue_wait(const T& value);
+
+	bool enqueue_wait(T&& value);
+
+	bool dequeue_wait(T& value);
+
+	// 关闭队列：之后开始的入队全部失败，唤醒所有等待者，已入队的元素仍可取出
+	// 与 close() 并发的入队可能成功，也可能失败
+	void close();
+
+	bool is_closed() const { return closed_.load(std::memory_order_acquire); }
+
+	// 汇总各线程的统计（stats_policy 为 lfq_no_stats 时全为0）
+	lfq_stats_snapshot stats() const { return stats_.snapshot(); }
+
+	// 驻留时间直方图的快照（latency_policy 为 lfq_no_latency 时为空），可在其他线程中随时调用
+	lfq_latency_snapshot latency() const { return latency_.snapshot(); }
+
+	// 松散判空；批量发布 head 时消费者只在追上可见的 tail 或出队失败时发布，取空后的判断仍然准确
 	bool empty() const;
 
-	~lfq_array_based() = default;
+	// 可同时容纳的元素个数
+	size_t capacity() const { return index_.usable(); }
+
+	// 析构队列中剩余的元素
+	~lfq_array_based();
 
 private:
-	struct Slot {
-		T data;
-		std::atomic<bool> ready = false; // ݾ־
+	using stamp_type = typename latency_type::slot_base;
+	static constexpr size_t data_align_ = alignof(T) > alignof(stamp_type) ? alignof(T) : alignof(stamp_type);
+	static constexpr size_t slot_align_ = data_align_ > layout_type::align ? data_align_ : layout_type::align;
+
+	static_assert(Traits::head_publish_interval >= 1, "head_publish_interval must be at least 1.");
+	// 单消费者且发布间隔大于1时，head_ 只按批发布
+	static constexpr bool batch_head_ = !consumer_type::multi && Traits::head_publish_interval > 1;
+
+	// 采样时间戳作为基类，不采样时为空基类，不占空间
+	struct alignas(slot_align_) Slot : stamp_type {
+		lfq_storage<T> data;				// 未初始化存储，ready 为 true 时其中有一个活着的 T
+		std::atomic<bool> ready = false; // 数据就绪标志
 	};
-	std::unique_ptr<Slot[]> buffer_ptr_;		// ӵл
-	Slot* const buffer_;           // ָ򻺳ԭָ룬ڷ
-	const size_t capacity_;		// 
-	//std::atomic<size_t> head_;	// 
-	//std::atomic<size_t> tail_;	// β
-	alignas(64) std::atomic<size_t> head_;
-	alignas(64) std::atomic<size_t> tail_;
-
-	// òλ״̬
+	using map_type = typename layout_type::template mapper<sizeof(Slot)>;
+
+	// 析构槽位并把缓冲区交还分配器
+	struct slot_deleter {
+		mutable allocator_type alloc;
+		size_t slots;
+
+		void operator()(Slot* p) const noexcept {
+			for (size_t i = 0; i < slots; ++i)
+				p[i].~Slot();
+			alloc.deallocate(p, slots * sizeof(Slot), alignof(Slot));
+		}
+	};
+	using buffer_type = std::unique_ptr<Slot[], slot_deleter>;
+
+	// 通过分配器申请缓冲区并构造全部槽位（容量为0时在分配前抛出异常）
+	static buffer_type create_buffer(size_t capacity, size_t slots, const allocator_type& alloc);
+
+	const index_type index_;	// 序号到槽位的映射
+	const map_type map_;		// 槽位下标重排（布局策略）
+	buffer_type buffer_ptr_;		// 拥有缓冲区
+	Slot* const buffer_;           // 指向缓冲区的原子指针，用于访问
+	const size_t capacity_;		// 可用容量
+	//std::atomic<size_t> head_;	// 队首索引
+	//std::atomic<size_t> tail_;	// 队尾索引
+	alignas(64) std::atomic<uint64_t> head_;	// 队首序号（单调递增）
+	std::atomic<uint64_t> tail_cache_;			// 消费者缓存的 tail，与 head_ 同一缓存行
+	alignas(64) std::atomic<uint64_t> tail_;	// 队尾序号（单调递增）
+	std::atomic<uint64_t> head_cache_;			// 生产者缓存的 head，与 tail_ 同一缓存行
+	alignas(64) uint64_t head_local_;			// 批量发布时单消费者私有的 head，可能领先 head_
+	size_t unpublished_;						// head_local_ 领先 head_ 的个数
+	alignas(64) wait_type not_empty_;			// 消费者等待数据
+	alignas(64) wait_type not_full_;			// 生产者等待空间
+	alignas(64) std::atomic<bool> closed_;		// 关闭标志，独占缓存行，运行期间只读
+	stats_type stats_;							// 统计，计数块按线程分开，不与上面的字段共享写入
+	latency_type latency_;						// 驻留时间直方图（只有采样到的出队才写入）
+	backoff_state_type backoff_state_;			// 退避策略跨操作的状态（自适应退避按线程的级别）
+
+	template <typename... Args>
+	bool emplace_impl(Args&&... args);
+
+	// 认领 tail 处的一个槽位，成功时 tail 为认领到的序号
+	bool claim_slot(uint64_t& tail);
+
+	// 已关闭且所有已认领的元素都已取走
+	bool drained() const;
+
+	template <typename U>
+	bool enqueue_wait_until(U&& value, lfq_clock::time_point deadline);
+
+	bool dequeue_impl(T& value);
+
+	bool dequeue_single(T& value);
+
+	bool dequeue_multi(T& value);
+
+	// 序号 -> 缓冲区下标
+	size_t slot_of(uint64_t seq) const { return map_(index_(seq)); }
+
+	// tail 之后能否再放入 n 个元素
+	// tail 可能是较早读取的值而小于最新的 head，因此按有符号差值比较
+	// 先用缓存的 head 判断，只有缓存显示空间不足时才读取消费者的 head_
+	// 缓存值只会偏旧（偏小），据此判断有空间一定成立
+	// 缓存以 release 写、acquire 读，保证读到缓存的生产者也能看到消费者清空槽位的结果
+	bool has_room(uint64_t tail, size_t n) {
+		auto fits = [&](uint64_t head) {
+			return static_cast<int64_t>(tail - head) + static_cast<int64_t>(n) <= static_cast<int64_t>(capacity_);
+		};
+		if constexpr (Traits::cache_indices) {
+			if (fits(head_cache_.load(std::memory_order_acquire)))
+				return true;
+		}
+		uint64_t const head = head_.load(std::memory_order_acquire);
+		if constexpr (Traits::cache_indices) {
+			head_cache_.store(head, std::memory_order_release);
+		}
+		return fits(head);
+	}
+
+	// 消费者视角的 tail：缓存值已能提供 want 个元素时直接使用，否则重新读取 tail_
+	// want 先截到容量（SIZE_MAX 等超过 INT64_MAX 的值转成有符号数会变成负数）
+	// 元素是否写完仍由 ready 标志确认
+	uint64_t visible_tail(uint64_t head, size_t want) {
+		if constexpr (Traits::cache_indices) {
+			uint64_t const cached = tail_cache_.load(std::memory_order_acquire);
+			want = std::min(want, capacity_);
+			if (static_cast<int64_t>(cached - head) >= static_cast<int64_t>(want))
+				return cached;
+		}
+		uint64_t const tail = tail_.load(std::memory_order_acquire);
+		if constexpr (Traits::cache_indices) {
+			tail_cache_.store(tail, std::memory_order_release);
+		}
+		return tail;
+	}
+
+	// 消费者开始出队时的头序号：单消费者批量发布时以私有的 head_local_ 为准，其余情况读取 head_
+	uint64_t consumer_head() const {
+		if constexpr (batch_head_) {
+			return head_local_;
+		}
+		else {
+			return head_.load(std::memory_order_relaxed);
+		}
+	}
+
+	// 单消费者取走 [head, head + n) 后推进头序号
+	// 批量发布时只在攒满 head_publish_interval 个或追上可见的 tail（队列看起来已空）时写 head_
+	void advance_head(uint64_t head, size_t n, uint64_t cur_tail) {
+		if constexpr (batch_head_) {
+			head_local_ = head + n;
+			unpublished_ += n;
+			if (unpublished_ >= Traits::head_publish_interval || head_local_ == cur_tail)
+				publish_head();
+		}
+		else {
+			head_.store(head + n, std::memory_order_release);
+		}
+	}
+
+	// 发布尚未写入 head_ 的进度；出队失败（空闲）时调用，生产者与 drained() 不会一直看到旧的 head
+	void publish_head() {
+		if constexpr (batch_head_) {
+			if (unpublished_ != 0) {
+				head_.store(head_local_, std::memory_order_release);
+				unpublished_ = 0;
+			}
+		}
+	}
+
+	// 单消费者清空槽位
+	// 批量发布时用 relaxed 写：生产者要等 head_ 越过该序号才会认领槽位，由随后 head_ 的 release 写发布
+	void clear_slot(size_t idx) {
+		buffer_[idx].ready.store(false, batch_head_ ? std::memory_order_relaxed : std::memory_order_release);
+	}
+
+	// CAS 失败后计数并按退避策略等待；等待过后重新读取序号，CAS 带回的值此时多半已过期
+	void back_off(backoff_type& backoff, const std::atomic<uint64_t>& seq, uint64_t& value) {
+		stats_.add(lfq_stat::cas_retry);
+		if constexpr (backoff_type::enabled) {
+			if (backoff.retry())
+				stats_.add(lfq_stat::backoff_yield);
+			value = seq.load(std::memory_order_relaxed);
+		}
+	}
+
+	// 设置槽位状态
 	void set_slot_ready(size_t idx, bool ready);
 
-	// λ״̬
+	// 检查槽位状态
 	bool is_slot_ready(size_t idx) const;
 };
 
-template <typename T>
-void lfq_array_based<T>::set_slot_ready(size_t idx, bool ready) {
+template <typename T, typename Traits>
+void lfq_array_based<T, Traits>::set_slot_ready(size_t idx, bool ready) {
 	buffer_[idx].ready.store(ready, std::memory_order_release);
 }
 
-template <typename T>
-bool lfq_array_based<T>::is_slot_ready(size_t idx) const {
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::is_slot_ready(size_t idx) const {
 	return buffer_[idx].ready.load(std::memory_order_acquire);
 }
 
-template <typename T>
-lfq_array_based<T>::lfq_array_based(size_t capacity)
-	: buffer_ptr_(static_cast<Slot*>(::operator new(sizeof(Slot)* capacity))), // ԭʼڴ
+template <typename T, typename Traits>
+lfq_array_based<T, Traits>::lfq_array_based(size_t capacity, const allocator_type& alloc)
+	: index_(capacity),
+	map_(index_.slots()),
+	buffer_ptr_(create_buffer(capacity, index_.slots(), alloc)),
 	buffer_(buffer_ptr_.get()),
-	capacity_(capacity),
+	capacity_(index_.usable()),
 	head_(0),
-	tail_(0) {
+	tail_cache_(0),
+	tail_(0),
+	head_cache_(0),
+	head_local_(0),
+	unpublished_(0),
+	closed_(false) {
+}
+
+template <typename T, typename Traits>
+typename lfq_array_based<T, Traits>::buffer_type lfq_array_based<T, Traits>::create_buffer(
+	size_t capacity, size_t slots, const allocator_type& alloc) {
 	if (capacity == 0) {
 		throw std::invalid_argument("Capacity must be greater than zero.");
 	}
 
-	// ڴϹSlot
-	for (size_t i = 0; i < capacity; ++i) {
-		new (&buffer_[i]) Slot();
+	slot_deleter deleter{ alloc, 0 };
+	Slot* p = static_cast<Slot*>(deleter.alloc.allocate(slots * sizeof(Slot), alignof(Slot)));
+
+	// 槽位只含未初始化存储与 ready 标志，构造不会抛出异常
+	for (size_t i = 0; i < slots; ++i)
+		::new (static_cast<void*>(p + i)) Slot();
+	deleter.slots = slots;
+	return buffer_type(p, deleter);
+}
+
+template <typename T, typename Traits>
+lfq_array_based<T, Traits>::~lfq_array_based() {
+	// 此时不应再有并发操作：ready 为 true 的槽位中都有尚未取走的元素
+	for (size_t i = 0; i < index_.slots(); ++i) {
+		if (buffer_[i].ready.load(std::memory_order_acquire))
+			buffer_[i].data.destroy();
 	}
 }
 
-template <typename T>
-bool lfq_array_based<T>::enqueue(const T& value) {
-	size_t tail = tail_.load(std::memory_order_relaxed);
-	size_t next_tail;
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T, typename Traits>
+template <typename... Args>
+bool lfq_array_based<T, Traits>::emplace(Args&&... args) {
+	if (!emplace_impl(std::forward<Args>(args)...))
+		return false;
+	not_empty_.notify();
+	return true;
+}
 
-	// 1. Ԥλ
-	do {
-		next_tail = (tail + 1) % capacity_;
+template <typename T, typename Traits>
+template <typename... Args>
+bool lfq_array_based<T, Traits>::emplace_impl(Args&&... args) {
+	uint64_t tail;
 
-		// ѭ¼headȷ״̬
-		if (next_tail == head_.load(std::memory_order_acquire)) {
-			return false; // 
+	// 1. 预留槽位
+	if (!claim_slot(tail))
+		return false;
+
+	// CAS成功后：当前线程独占地拥有tail槽位
+	// 2. 原地构造元素（CAS 失败时参数不会被移动）
+	size_t const idx = slot_of(tail);
+	buffer_[idx].data.construct(std::forward<Args>(args)...);
+	latency_.on_enqueue(buffer_[idx], tail);
+
+	// 3. 发布数据可用状态
+	set_slot_ready(idx, true);
+
+	stats_.add(lfq_stat::enqueued);
+	return true;
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::claim_slot(uint64_t& tail) {
+	// 关闭检查只是一次普通读取，不增加原子读改写
+	if (closed_.load(std::memory_order_acquire))
+		return false;
+
+	tail = tail_.load(std::memory_order_relaxed);
+	backoff_type backoff(backoff_state_);
+
+	for (;;) {
+		// 在循环内重新加载head，确保最新状态
+		// 序号单调递增，差值即为当前元素个数，不存在回绕的ABA问题
+		if (!has_room(tail, 1)) {
+			stats_.add(lfq_stat::full);
+			return false; // 队列已满
 		}
 
-		//  CASǰղ
-		if (is_slot_ready(tail))
+		// ★ 在CAS前检查空槽
+		if (is_slot_ready(slot_of(tail))) {
+			stats_.add(lfq_stat::slot_busy);
 			return false;
-	} while (!tail_.compare_exchange_weak(
-		tail,
-		next_tail,
-		std::memory_order_acq_rel,  // ɹʱʹøǿڴ
-		std::memory_order_relaxed));
+		}
 
-	// CASɹ󣺵ǰ̶߳ռӵtailλ
-	// 2. ȫд
-	buffer_[tail].data = value;
+		if (tail_.compare_exchange_weak(
+			tail,
+			tail + 1,
+			std::memory_order_acq_rel,  // 成功时使用更强的内存序
+			std::memory_order_relaxed))
+			break;
+		back_off(backoff, tail_, tail);
+	}
+	backoff.success();
+
+	// 占用水位：只在打开统计时读取消费者的 head_
+	if constexpr (stats_type::enabled) {
+		stats_.observe_depth(tail + 1 - head_.load(std::memory_order_relaxed));
+	}
+	return true;
+}
 
-	// 3. ݿ״̬
-	set_slot_ready(tail, true);
+template <typename T, typename Traits>
+template <typename... Args>
+T* lfq_array_based<T, Traits>::try_reserve(Args&&... args) {
+	uint64_t tail;
+	if (!claim_slot(tail))
+		return nullptr; // 队列已满
+
+	// 槽位已归本线程所有，但 ready 仍为 false，消费者看不到
+	// 驻留时间从预留时算起，包含调用方填写数据的时间
+	stats_.add(lfq_stat::enqueued);
+	latency_.on_enqueue(buffer_[slot_of(tail)], tail);
+	if constexpr (sizeof...(Args) == 0)
+		return buffer_[slot_of(tail)].data.construct_default();
+	else
+		return buffer_[slot_of(tail)].data.construct(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Traits>
+void lfq_array_based<T, Traits>::commit(T* reserved) {
+	// 元素位于槽位内部（采样时间戳作为基类排在它前面），减去元素在槽位中的偏移后反推槽位下标
+	unsigned char* const base = reinterpret_cast<unsigned char*>(buffer_);
+	size_t const data_offset = static_cast<size_t>(reinterpret_cast<unsigned char*>(buffer_[0].data.get()) - base);
+	size_t const idx = static_cast<size_t>(reinterpret_cast<unsigned char*>(reserved) - base - data_offset) / sizeof(Slot);
+	assert(idx < index_.slots() && buffer_[idx].data.get() == reserved);
+
+	set_slot_ready(idx, true);
+	not_empty_.notify();
+}
 
+template <typename T, typename Traits>
+T* lfq_array_based<T, Traits>::peek() {
+	static_assert(!consumer_type::multi, "peek/release require a single consumer.");
+
+	uint64_t const head = consumer_head();
+	uint64_t const cur_tail = visible_tail(head, 1);
+	size_t const idx = slot_of(head);
+	if (head == cur_tail || !is_slot_ready(idx)) {
+		publish_head();
+		return nullptr;
+	}
+	return buffer_[idx].data.get();
+}
+
+template <typename T, typename Traits>
+void lfq_array_based<T, Traits>::release() {
+	static_assert(!consumer_type::multi, "peek/release require a single consumer.");
+
+	// 调用前必须已由 peek 取得队首元素
+	uint64_t const head = consumer_head();
+	size_t const idx = slot_of(head);
+	assert(is_slot_ready(idx));
+
+	// 1. 析构元素并标记槽位为空
+	buffer_[idx].data.destroy();
+	latency_.on_dequeue(buffer_[idx], head);
+	clear_slot(idx);
+	stats_.add(lfq_stat::dequeued);
+
+	// 2. 更新头序号（peek 已确认 tail 在 head 之后，缓存的 tail 可直接使用）
+	advance_head(head, 1, visible_tail(head, 1));
+	not_full_.notify();
+}
+
+template <typename T, typename Traits>
+template <typename It>
+bool lfq_array_based<T, Traits>::enqueue_bulk(It first, size_t n) {
+	if (n == 0) {
+		return true;
+	}
+
+	// 超过容量的批量永远放不下（has_room 按有符号数比较，也不能让 n 超过 INT64_MAX）
+	if (n > capacity_ || closed_.load(std::memory_order_acquire)) {
+		return false;
+	}
+
+	uint64_t tail = tail_.load(std::memory_order_relaxed);
+	backoff_type backoff(backoff_state_);
+
+	// 1. 一次 CAS 预留 [tail, tail + n)
+	for (;;) {
+		if (!has_room(tail, n)) {
+			stats_.add(lfq_stat::full);
+			return false; // 剩余空间不足
+		}
+
+		// 多消费者时上一圈的槽位可能已被认领但尚未清空
+		for (size_t i = 0; i < n; ++i) {
+			if (is_slot_ready(slot_of(tail + i))) {
+				stats_.add(lfq_stat::slot_busy);
+				return false;
+			}
+		}
+
+		if (tail_.compare_exchange_weak(
+			tail,
+			tail + n,
+			std::memory_order_acq_rel,
+			std::memory_order_relaxed))
+			break;
+		back_off(backoff, tail_, tail);
+	}
+	backoff.success();
+
+	if constexpr (stats_type::enabled) {
+		stats_.observe_depth(tail + n - head_.load(std::memory_order_relaxed));
+	}
+
+	// 2. 写入数据
+	for (size_t i = 0; i < n; ++i, ++first) {
+		Slot& slot = buffer_[slot_of(tail + i)];
+		slot.data.construct(*first);
+		latency_.on_enqueue(slot, tail + i);
+	}
+
+	// 3. 依次发布（普通的 release 写，无原子读改写）
+	for (size_t i = 0; i < n; ++i) {
+		set_slot_ready(slot_of(tail + i), true);
+	}
+
+	stats_.add(lfq_stat::enqueued, n);
+
+	not_empty_.notify();
 	return true;
 }
 
-template <typename T>
-bool lfq_array_based<T>::enqueue(T&& value) {
-	size_t tail = tail_.load(std::memory_order_relaxed);
-	size_t next_tail;
+template <typename T, typename Traits>
+template <typename OutIt>
+size_t lfq_array_based<T, Traits>::dequeue_bulk(OutIt out, size_t max) {
+	uint64_t head = consumer_head();
+	uint64_t cur_tail;
+	size_t count;
+	backoff_type backoff(backoff_state_);
+
+	// 1. 统计从 head 开始连续就绪的槽位
+	for (;;) {
+		cur_tail = visible_tail(head, max);
+		size_t const avail = static_cast<int64_t>(cur_tail - head) > 0 ? static_cast<size_t>(cur_tail - head) : 0;
+		size_t const limit = avail < max ? avail : max;
+
+		count = 0;
+		while (count < limit && is_slot_ready(slot_of(head + count)))
+			++count;
+
+		if (count == 0) {
+			publish_head();
+			stats_.add(avail == 0 ? lfq_stat::empty : lfq_stat::not_ready);
+			return 0;
+		}
 
-	// 1. Ԥλ
-	do {
-		next_tail = (tail + 1) % capacity_;
+		if constexpr (!consumer_type::multi) {
+			break;
+		}
+		else {
+			// 多消费者：一次 CAS 认领整段
+			if (head_.compare_exchange_weak(
+				head,
+				head + count,
+				std::memory_order_acq_rel,
+				std::memory_order_relaxed))
+				break;
+			back_off(backoff, head_, head);
+		}
+	}
+	if constexpr (consumer_type::multi) {
+		backoff.success();
+	}
 
-		// ѭ¼headȷ״̬
-		if (next_tail == head_.load(std::memory_order_acquire)) {
-			return false; // 
+	// 2. 读取数据并清空槽位
+	for (size_t i = 0; i < count; ++i, ++out) {
+		size_t const idx = slot_of(head + i);
+		T* p = buffer_[idx].data.get();
+		*out = std::move(*p);
+		p->~T();
+		latency_.on_dequeue(buffer_[idx], head + i);
+		if constexpr (consumer_type::multi) {
+			set_slot_ready(idx, false);
 		}
+		else {
+			clear_slot(idx);
+		}
+	}
 
-		//  CASǰղ
-		if (is_slot_ready(tail))
+	// 3. 单消费者只在最后更新一次 head（批量发布时可能继续推迟）
+	if constexpr (!consumer_type::multi) {
+		advance_head(head, count, cur_tail);
+	}
+
+	stats_.add(lfq_stat::dequeued, count);
+
+	not_full_.notify();
+	return count;
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::dequeue(T& value) {
+	if (!dequeue_impl(value))
+		return false;
+	not_full_.notify();
+	return true;
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::dequeue_impl(T& value) {
+	if constexpr (consumer_type::multi) {
+		return dequeue_multi(value);
+	}
+	else {
+		return dequeue_single(value);
+	}
+}
+
+template <typename T, typename Traits>
+template <typename U>
+bool lfq_array_based<T, Traits>::enqueue_wait_until(U&& value, lfq_clock::time_point deadline) {
+	// 入队失败时 value 不会被移动，可以反复尝试；队列关闭时结束等待
+	bool ok = false;
+	not_full_.wait_until([&] {
+		ok = emplace_impl(std::forward<U>(value));
+		return ok || is_closed();
+		}, deadline);
+	if (ok)
+		not_empty_.notify();
+	return ok;
+}
+
+template <typename T, typename Traits>
+template <typename Rep, typename Period>
+bool lfq_array_based<T, Traits>::enqueue_wait(const T& value, const std::chrono::duration<Rep, Period>& timeout) {
+	return enqueue_wait_until(value, lfq_deadline(timeout));
+}
+
+template <typename T, typename Traits>
+template <typename Rep, typename Period>
+bool lfq_array_based<T, Traits>::enqueue_wait(T&& value, const std::chrono::duration<Rep, Period>& timeout) {
+	return enqueue_wait_until(std::move(value), lfq_deadline(timeout));
+}
+
+template <typename T, typename Traits>
+template <typename Rep, typename Period>
+bool lfq_array_based<T, Traits>::dequeue_wait(T& value, const std::chrono::duration<Rep, Period>& timeout) {
+	// 关闭后继续取出剩余元素，取空才结束等待
+	bool ok = false;
+	not_empty_.wait_until([&] {
+		ok = dequeue_impl(value);
+		return ok || drained();
+		}, lfq_deadline(timeout));
+	if (ok)
+		not_full_.notify();
+	return ok;
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::enqueue_wait(const T& value) {
+	return enqueue_wait_until(value, lfq_clock::time_point::max());
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::enqueue_wait(T&& value) {
+	return enqueue_wait_until(std::move(value), lfq_clock::time_point::max());
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::dequeue_wait(T& value) {
+	return dequeue_wait(value, lfq_clock::duration::max());
+}
+
+template <typename T, typename Traits>
+void lfq_array_based<T, Traits>::close() {
+	closed_.store(true, std::memory_order_seq_cst);
+
+	// 等待策略的 notify 只在有等待者时才发起唤醒
+	not_empty_.notify();
+	not_full_.notify();
+}
+
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::drained() const {
+	if (!closed_.load(std::memory_order_acquire))
+		return false;
+	// 已认领但尚未写完的元素也要等它写完后取走
+	return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+}
+
+// 多消费者时实现
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::dequeue_multi(T& value) {
+	uint64_t head = head_.load(std::memory_order_relaxed);
+	size_t idx;
+	backoff_type backoff(backoff_state_);
+
+	// 1. 认领槽位
+	for (;;) {
+		uint64_t const cur_tail = visible_tail(head, 1);
+
+		// 检查队列是否为空
+		if (head == cur_tail) {
+			stats_.add(lfq_stat::empty);
+			return false; // 队列为空
+		}
+
+		// 生产者已认领但尚未写完
+		idx = slot_of(head);
+		if (!is_slot_ready(idx)) {
+			stats_.add(lfq_stat::not_ready);
 			return false;
-	} while (!tail_.compare_exchange_weak(
-		tail,
-		next_tail,
-		std::memory_order_acq_rel,  // ɹʱʹøǿڴ
-		std::memory_order_relaxed));
+		}
+
+		// 尝试CAS更新head
+		// 如果成功，当前消费者获得该元素的读取权
+		// 序号单调递增，过期的head不会CAS成功，也就不会读到其他圈的数据
+		if (head_.compare_exchange_weak(
+			head,
+			head + 1,
+			std::memory_order_acq_rel,  // 成功时使用获取-释放内存序
+			std::memory_order_relaxed)) // 失败时使用宽松内存序
+			break;
+		back_off(backoff, head_, head);
+	}
+	backoff.success();
 
-	// CASɹ󣺵ǰ̶߳ռӵtailλ
-	// 2. ȫд
-	buffer_[tail].data = std::move(value);
+	// CAS成功后：当前线程独占地拥有head槽位
+	// 2. 读取数据并析构槽位中的元素
+	buffer_[idx].data.move_to(value);
+	latency_.on_dequeue(buffer_[idx], head);
 
-	// 3. ݿ״̬
-	set_slot_ready(tail, true);
+	// 3. 标记槽位为空，下一圈的生产者才能写入
+	set_slot_ready(idx, false);
 
+	stats_.add(lfq_stat::dequeued);
 	return true;
 }
 
-// ʱʵ
-//template <typename T>
-//bool lfq_array_based<T>::dequeue(T& value) {
-//	size_t head;
-//	size_t next_head;
-//	T* current_slot;
-//
-//	do {
-//		head = head_.load(std::memory_order_relaxed);
-//		size_t const cur_tail = tail_.load(std::memory_order_acquire);
-//
-//		// ǷΪ
-//		if (head == cur_tail) {
-//			return false; // Ϊ
-//		}
-//
-//		// ¼һҪȡλ
-//		next_head = (head + 1) % capacity_;
-//		current_slot = &buffer_[head];
-//
-//		// CASheadָ
-//		// ɹǰ߻øԪصĶȡȨ
-//	} while (!head_.compare_exchange_weak(
-//		head,
-//		next_head,
-//		std::memory_order_acq_rel,  // ɹʱʹûȡ-ͷڴ
-//		std::memory_order_relaxed)); // ʧʱʹÿڴ
-//
-//	// CASɹ󣺵ǰ̶߳ռӵheadλ
-//	value = std::move(*current_slot);
-//
-//	// ȷݼ
-//	std::atomic_thread_fence(std::memory_order_release);
-//
-//	return true;
-//}
-
-
-// ʱʵ
-template <typename T>
-bool lfq_array_based<T>::dequeue(T& value) {
-	size_t head = head_.load(std::memory_order_relaxed);
-
-	// ʹacquireȡtail
-	size_t const cur_tail = tail_.load(std::memory_order_acquire);
-	// 1. ȷ׼
-	if (head == cur_tail || !is_slot_ready(head)) {
+
+// 单消费者时实现
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::dequeue_single(T& value) {
+	uint64_t const head = consumer_head();
+
+	// 必须使用acquire读取tail（缓存的 tail 显示为空时才重新读取）
+	uint64_t const cur_tail = visible_tail(head, 1);
+	size_t const idx = slot_of(head);
+	// 1. 确保数据已准备好
+	if (head == cur_tail) {
+		publish_head();
+		stats_.add(lfq_stat::empty);
+		return false;
+	}
+	if (!is_slot_ready(idx)) {
+		publish_head();
+		stats_.add(lfq_stat::not_ready);
 		return false;
 	}
 
-	// 2. ȡ
-	value = std::move(buffer_[head].data);
+	// 2. 读取数据并析构槽位中的元素
+	buffer_[idx].data.move_to(value);
+	latency_.on_dequeue(buffer_[idx], head);
 
-	// 3. ǲλΪ
-	set_slot_ready(head, false);
+	// 3. 标记槽位为空
+	clear_slot(idx);
 
-	// 4. ͷָ
-	head_.store((head + 1) % capacity_, std::memory_order_release);
+	// 4. 更新头序号（批量发布时可能推迟）
+	advance_head(head, 1, cur_tail);
+	stats_.add(lfq_stat::dequeued);
 	return true;
 }
 
 
-template <typename T>
-bool lfq_array_based<T>::empty() const {
-	// ʹrelaxedأΪֵֻͬ
-	// ɢпգ֤ȷ
-	size_t head = head_.load(std::memory_order_relaxed);
-	size_t tail = tail_.load(std::memory_order_relaxed);
+template <typename T, typename Traits>
+bool lfq_array_based<T, Traits>::empty() const {
+	// 松散判空，只作参考（已认领但尚未写完的元素也算非空）
+	// 先以 acquire 读取 head：消费者推进 head 之前已读到 tail >= 新的 head，随后读到的 tail 不会比 head 旧
+	// 两次都用 relaxed 时可能读到新的 head 与旧的 tail，head > tail 时误判为非空
+	uint64_t const head = head_.load(std::memory_order_acquire);
+	uint64_t const tail = tail_.load(std::memory_order_relaxed);
 	return head == tail;
 }
\ No newline at end of file
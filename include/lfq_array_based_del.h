@@ -1,265 +0,0 @@
-#pragma once
-
-#include <vector>
-#include <atomic>
-#include <memory>
-
-#include <stdexcept>
-#include <cassert>
-#include <iostream>
-
-template <typename T>
-class lfq_array_based {
-public:
-	explicit lfq_array_based(size_t capacity);
-
-	bool enqueue(const T& value);
-
-	bool enqueue(T&& value);
-
-	bool dequeue(T& value);
-
-	bool empty() const;
-
-	~lfq_array_based() noexcept;
-
-private:
-	void clear_remaining() noexcept;
-
-	bool dequeue_impl(T& value) noexcept;
-
-	bool is_buffer_empty() const noexcept
-
-	std::unique_ptr<T[]> buffer_ptr_;  // ӵл
-	std::atomic<T*> buffer_;           // ָ򻺳ԭָ룬ڷ
-	const size_t capacity_;		// 
-	//std::atomic<size_t> head_;	// 
-	//std::atomic<size_t> tail_;	// β
-	alignas(64) std::atomic<size_t> head_;
-	alignas(64) std::atomic<size_t> tail_;
-
-	std::atomic<bool> shutdown_{ false }; // ڰȫرն
-	std::atomic<size_t> active_operations_{ 0 };    // 
-};
-
-template <typename T>
-lfq_array_based<T>::lfq_array_based(size_t capacity)
-	: buffer_ptr_(std::make_unique<T[]>(capacity)),
-	buffer_(buffer_ptr_.get()),
-	capacity_(capacity),
-	head_(0),
-	tail_(0) {
-	if (capacity == 0) {
-		throw std::invalid_argument("Capacity must be greater than zero.");
-	}
-};
-
-template <typename T>
-bool lfq_array_based<T>::enqueue(const T& value) {
-	if (shutdown_.load(std::memory_order_acquire)) {
-		return false; // ѹرվܾ²
-	}
-
-	active_operations_.fetch_add(1, std::memory_order_acq_rel);
-
-	size_t tail = tail_.load(std::memory_order_relaxed);
-	size_t next_tail;
-	T* current_slot;  // ڰȫʻ
-
-	do {
-		next_tail = (tail + 1) % capacity_;
-
-		// ѭ¼headȷ״̬
-		if (next_tail == head_.load(std::memory_order_acquire)) {
-			return false; // 
-		}
-
-		// ؼڴ˴д!
-	} while (!tail_.compare_exchange_weak(
-		tail,
-		next_tail,
-		std::memory_order_acq_rel,  // ɹʱʹøǿڴ
-		std::memory_order_relaxed));
-
-	// CASɹ󣺵ǰ̶߳ռӵtailλ
-	// ȡλָ루ԭӷʣ
-	current_slot = &buffer_[tail];
-
-	// дݣʱᾺ
-	*current_slot = value;
-
-	// ȷݶ߿ɼ
-	std::atomic_thread_fence(std::memory_order_release);
-
-	active_operations_.fetch_sub(1, std::memory_order_release);
-
-	return true;
-}
-
-template <typename T>
-bool lfq_array_based<T>::enqueue(T&& value) {
-	if (shutdown_.load(std::memory_order_acquire)) {
-		return false; // ѹرվܾ²
-	}
-
-	active_operations_.fetch_add(1, std::memory_order_acq_rel);
-
-	size_t tail = tail_.load(std::memory_order_relaxed);
-	size_t next_tail;
-	T* current_slot;  // ڰȫʻ
-
-	do {
-		next_tail = (tail + 1) % capacity_;
-
-		// ѭ¼headȷ״̬
-		if (next_tail == head_.load(std::memory_order_acquire)) {
-			return false; // 
-		}
-
-		// ؼڴ˴д!
-	} while (!tail_.compare_exchange_weak(
-		tail,
-		next_tail,
-		std::memory_order_acq_rel,  // ɹʱʹøǿڴ
-		std::memory_order_relaxed));
-
-	// CASɹ󣺵ǰ̶߳ռӵtailλ
-	// ȡλָ루ԭӷʣ
-	current_slot = &buffer_[tail];
-
-	// дݣʱᾺ
-	*current_slot = move(value);
-
-	// ȷݶ߿ɼ
-	std::atomic_thread_fence(std::memory_order_release);
-
-	active_operations_.fetch_sub(1, std::memory_order_release);
-
-	return true;
-}
-
-// ʱʵ
-//template <typename T>
-//bool lfq_array_based<T>::dequeue(T& value) {
-//	size_t head;
-//	size_t next_head;
-//	T* current_slot;
-//
-//	do {
-//		head = head_.load(std::memory_order_relaxed);
-//		size_t const cur_tail = tail_.load(std::memory_order_acquire);
-//
-//		// ǷΪ
-//		if (head == cur_tail) {
-//			return false; // Ϊ
-//		}
-//
-//		// ¼һҪȡλ
-//		next_head = (head + 1) % capacity_;
-//		current_slot = &buffer_[head];
-//
-//		// CASheadָ
-//		// ɹǰ߻øԪصĶȡȨ
-//	} while (!head_.compare_exchange_weak(
-//		head,
-//		next_head,
-//		std::memory_order_acq_rel,  // ɹʱʹûȡ-ͷڴ
-//		std::memory_order_relaxed)); // ʧʱʹÿڴ
-//
-//	// CASɹ󣺵ǰ̶߳ռӵheadλ
-//	value = std::move(*current_slot);
-//
-//	// ȷݼ
-//	std::atomic_thread_fence(std::memory_order_release);
-//
-//	return true;
-//}
-
-
-// ʱʵ
-template <typename T>
-bool lfq_array_based<T>::dequeue(T& value) {
-	if (shutdown_.load(std::memory_order_acquire)) {
-		return false; // ѹرվܾ²
-	}
-
-	active_operations_.fetch_add(1, std::memory_order_acq_rel);
-
-	size_t head = head_.load(std::memory_order_relaxed);
-
-	// ʹacquireȡtail
-	size_t const cur_tail = tail_.load(std::memory_order_acquire);
-	if (head == cur_tail) {
-		return false; // Ϊ
-	}
-
-	// ȷȷĻ
-	T* current_slot = &buffer_[head];
-	value = std::move(*current_slot);
-
-	// headʹrelease֤˳
-	head_.store((head + 1) % capacity_, std::memory_order_release);
-
-	active_operations_.fetch_sub(1, std::memory_order_release);
-	return true;
-}
-
-
-template <typename T>
-bool lfq_array_based<T>::empty() const {
-	// ʹrelaxedأΪֵֻͬ
-	// ɢпգ֤ȷ
-	size_t head = head_.load(std::memory_order_relaxed);
-	size_t tail = tail_.load(std::memory_order_relaxed);
-	return head == tail;
-}
-
-
-template <typename T>
-lfq_array_based<T>::~lfq_array_based() noexcept {
-	// ȫ٣ֱв
-	shutdown_.store(true, std::memory_order_release);
-
-	// ȴ/˳
-	while (active_operations_.load(std::memory_order_acquire) > 0) {
-		std::this_thread::yield();
-	}
-
-	// ǿʣԪ
-	clear_remaining();
-}
-
-
-// private func
-
-template <typename T>
-void lfq_array_based<T>::clear_remaining() noexcept {
-	T temp;
-	// ֻնд
-	while (!is_buffer_empty()) {
-		if (dequeue_impl(temp)) {
-			// ԪʱԶ
-		}
-	}
-}
-
-template <typename T>
-bool lfq_array_based<T>::dequeue_impl(T& value) noexcept {
-	// ڲʵ֣shutdown_
-	// (ʹԭdequeue߼߳ͬ)
-	size_t head = head_.load(std::memory_order_relaxed);
-	if (head == tail_.load(std::memory_order_relaxed)) {
-		return false;
-	}
-
-	value = std::move(buffer_[head]);
-	head_.store((head + 1) % capacity_, std::memory_order_release);
-	return true;
-}
-
-template <typename T>
-bool lfq_array_based<T>::is_buffer_empty() const noexcept {
-	// ֱӱȽǷ
-	return head_.load(std::memory_order_relaxed) ==
-		tail_.load(std::memory_order_relaxed);
-}
\ No newline at end of file
@@ -0,0 +1,294 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include <stdexcept>
+
+#include "lfq_common.h"
+#include "lfq_traits.h"
+#include "lfq_storage.h"
+
+// 下标环（SCQ，Nikolaev 2019）：存放 [0, n) 中的下标，最多同时存放 n 个，内部有 2n 个64位槽位
+// 生产者/消费者用一次 fetch_add 取得序号（票据），不在 head/tail 上做 CAS 重试，冲突在槽位上解决
+//   槽位 = cycle << (order + 1) | safe << order | index    （2n = 1 << order，index 全1表示空）
+//   cycle  槽位当前所属的圈数（序号 >> order）
+//   safe   清零表示曾有消费者越过该槽位而槽位中仍是上一圈的下标，此后只有 head 尚未越过其序号的生产者才能写入
+// 序号 t 的生产者：槽位为空、圈数小于 t 的圈数（不安全时另需 head <= t）则一次 CAS 写入下标，否则放弃该序号重新取号
+// 序号 h 的消费者：
+//   圈数等于 h 的圈数    取走下标（把 index 置为全1）
+//   空且圈数更小         把圈数推进到 h 的圈数（毒化），序号 h 的生产者到达后会放弃
+//   存有更早一圈的下标   清除 safe 位，防止序号 h 的生产者在本消费者离开后写入
+// 下标在 CAS 中一次写入，消费者从不等待生产者；threshold 限制消费者在空队列上连续放弃的序号个数（3n - 1），
+// 入队成功时重置，降到负数后出队直接返回空，不再取号
+class lfq_scq_ring {
+public:
+	// 容纳 [0, n) 中的下标，n 为2的幂；full 为 true 时初始存放全部 n 个下标
+	lfq_scq_ring(size_t n, bool full);
+
+	lfq_scq_ring(const lfq_scq_ring&) = delete;
+	lfq_scq_ring& operator=(const lfq_scq_ring&) = delete;
+
+	// 环中的下标从不超过 n 个，入队总是成功
+	void enqueue(uint64_t index);
+
+	bool dequeue(uint64_t& index);
+
+	// 松散判空，只作参考
+	bool empty() const;
+
+private:
+	static constexpr size_t line_shift = 3;	// 每个缓存行 8 个槽位
+
+	// n 为2的幂
+	static size_t log2_of(size_t n) {
+		size_t bits = 0;
+		while ((size_t(1) << bits) < n)
+			++bits;
+		return bits;
+	}
+
+	uint64_t make_entry(uint64_t cycle, uint64_t safe, uint64_t index) const { return cycle << (order_ + 1) | safe | index; }
+	uint64_t cycle_of(uint64_t entry) const { return entry >> (order_ + 1); }
+	uint64_t safe_of(uint64_t entry) const { return entry & safe_bit_; }
+	uint64_t index_of(uint64_t entry) const { return entry & mask_; }
+
+	// 相邻序号分散到不同缓存行，减少取号相邻的线程互相争抢
+	size_t remap(uint64_t pos) const;
+
+	// 消费者越过 tail 后把 tail 追到 head，避免之后的生产者逐个放弃已被毒化的序号
+	void catchup(uint64_t tail, uint64_t head);
+
+	const size_t order_;		// 槽位数 = 1 << order_
+	const uint64_t mask_;		// 槽位数 - 1，同时是空下标
+	const uint64_t safe_bit_;	// 1 << order_
+	const int64_t threshold_max_;	// 3n - 1
+	std::unique_ptr<std::atomic<uint64_t>[]> entries_;
+	alignas(64) std::atomic<uint64_t> head_;	// 消费者序号
+	alignas(64) std::atomic<uint64_t> tail_;	// 生产者序号
+	alignas(64) std::atomic<int64_t> threshold_;	// 出队还可连续放弃的序号个数
+};
+
+inline lfq_scq_ring::lfq_scq_ring(size_t n, bool full)
+	: order_(log2_of(n) + 1),
+	mask_((uint64_t(1) << order_) - 1),
+	safe_bit_(uint64_t(1) << order_),
+	threshold_max_(static_cast<int64_t>(3 * n) - 1),
+	entries_(new std::atomic<uint64_t>[size_t(1) << order_]),
+	head_(mask_ + 1),
+	tail_(mask_ + 1),
+	threshold_(-1) {
+	// 序号从第1圈开始，全部槽位为第0圈的空槽位
+	for (size_t i = 0; i <= mask_; ++i) {
+		entries_[i].store(make_entry(0, safe_bit_, mask_), std::memory_order_relaxed);
+	}
+	if (full) {
+		for (size_t i = 0; i < n; ++i) {
+			entries_[remap(mask_ + 1 + i)].store(make_entry(1, safe_bit_, i), std::memory_order_relaxed);
+		}
+		tail_.store(mask_ + 1 + n, std::memory_order_relaxed);
+		threshold_.store(threshold_max_, std::memory_order_relaxed);
+	}
+}
+
+inline size_t lfq_scq_ring::remap(uint64_t pos) const {
+	size_t const i = static_cast<size_t>(pos & mask_);
+	if (order_ <= line_shift)
+		return i;
+	// 低位（行号）与高位（行内位置）互换，相邻序号落在相邻的缓存行
+	return (i >> (order_ - line_shift)) | ((i << line_shift) & mask_);
+}
+
+inline void lfq_scq_ring::enqueue(uint64_t index) {
+	for (;;) {
+		// 1. 取号
+		uint64_t const t = tail_.fetch_add(1);
+		uint64_t const cycle = t >> order_;
+		std::atomic<uint64_t>& entry = entries_[remap(t)];
+		uint64_t e = entry.load();
+
+		// 2. 槽位为空且属于更早的圈：一次 CAS 写入下标
+		while (cycle_of(e) < cycle && index_of(e) == mask_ &&
+			(safe_of(e) || static_cast<int64_t>(head_.load() - t) <= 0)) {
+			if (entry.compare_exchange_weak(e, make_entry(cycle, safe_bit_, index))) {
+				if (threshold_.load() != threshold_max_)
+					threshold_.store(threshold_max_);
+				return;
+			}
+		}
+
+		// 3. 该序号不可用（槽位仍有上一圈的下标，或已被消费者毒化），重新取号
+	}
+}
+
+inline bool lfq_scq_ring::dequeue(uint64_t& index) {
+	// 最近连续放弃的序号过多：队列为空，不再取号
+	if (threshold_.load() < 0)
+		return false;
+
+	for (;;) {
+		// 1. 取号
+		uint64_t const h = head_.fetch_add(1);
+		uint64_t const cycle = h >> order_;
+		std::atomic<uint64_t>& entry = entries_[remap(h)];
+		uint64_t e = entry.load();
+
+		// 2. 按槽位状态处理本序号，任何情况下都不等待
+		for (;;) {
+			if (cycle_of(e) == cycle) {
+				// 取走下标，保留圈数与 safe 位
+				entry.fetch_or(mask_);
+				index = index_of(e);
+				return true;
+			}
+
+			// 空槽位：推进圈数（毒化）；存有更早一圈的下标：清除 safe 位
+			uint64_t next = e & ~safe_bit_;
+			if (index_of(e) == mask_)
+				next = make_entry(cycle, safe_of(e), mask_);
+			if (cycle_of(e) < cycle && !entry.compare_exchange_weak(e, next))
+				continue;
+			break;
+		}
+
+		// 3. 该序号没有下标：已取到 tail 则为空，否则重新取号
+		uint64_t const t = tail_.load();
+		if (static_cast<int64_t>(t - (h + 1)) <= 0) {
+			catchup(t, h + 1);
+			threshold_.fetch_sub(1);
+			return false;
+		}
+		if (threshold_.fetch_sub(1) <= 0)
+			return false;
+	}
+}
+
+inline void lfq_scq_ring::catchup(uint64_t tail, uint64_t head) {
+	while (!tail_.compare_exchange_weak(tail, head)) {
+		head = head_.load();
+		tail = tail_.load();
+		if (static_cast<int64_t>(tail - head) >= 0)
+			return;
+	}
+}
+
+inline bool lfq_scq_ring::empty() const {
+	return static_cast<int64_t>(tail_.load(std::memory_order_relaxed) - head_.load(std::memory_order_relaxed)) <= 0;
+}
+
+// 有界多生产者多消费者队列：元素存放在 n 个数据槽位中，两个 lfq_scq_ring 传递槽位下标
+//   free_   空闲槽位的下标，初始存放全部 n 个
+//   ready_  已写好数据的槽位下标，按入队顺序
+// 入队：从 free_ 取一个下标（取不到即已满），在该槽位上构造元素，再把下标放入 ready_
+// 出队：从 ready_ 取一个下标（取不到即为空），移出元素，再把下标还给 free_
+// 元素在发布下标之前写完，正在构造元素的生产者不会挡住消费者；其余生产者、消费者照常进行（无锁）
+// 容量向上取整为2的幂；槽位为未初始化存储，入队时原地构造、出队时析构
+template <typename T>
+class lfq_array_faa {
+public:
+	explicit lfq_array_faa(size_t capacity);
+
+	lfq_array_faa(const lfq_array_faa&) = delete;
+	lfq_array_faa& operator=(const lfq_array_faa&) = delete;
+
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	bool dequeue(T& value);
+
+	bool empty() const;
+
+	size_t capacity() const { return capacity_; }
+
+	// 析构队列中剩余的元素
+	~lfq_array_faa();
+
+private:
+	static size_t checked_capacity(size_t capacity);
+
+	const size_t capacity_;							// 数据槽位数
+	std::unique_ptr<lfq_storage<T>[]> data_;		// 数据槽位
+	lfq_scq_ring free_;								// 空闲槽位下标
+	lfq_scq_ring ready_;							// 已就绪槽位下标
+};
+
+template <typename T>
+size_t lfq_array_faa<T>::checked_capacity(size_t capacity) {
+	if (capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+	return lfq_round_up_pow2(capacity);
+}
+
+template <typename T>
+lfq_array_faa<T>::lfq_array_faa(size_t capacity)
+	: capacity_(checked_capacity(capacity)),
+	data_(new lfq_storage<T>[capacity_]),
+	free_(capacity_, true),
+	ready_(capacity_, false) {
+}
+
+template <typename T>
+lfq_array_faa<T>::~lfq_array_faa() {
+	uint64_t index;
+	while (ready_.dequeue(index))
+		data_[index].destroy();
+}
+
+template <typename T>
+bool lfq_array_faa<T>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T>
+bool lfq_array_faa<T>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+bool lfq_array_faa<T>::emplace(Args&&... args) {
+	// 1. 认领空闲槽位
+	uint64_t index;
+	if (!free_.dequeue(index))
+		return false;
+
+	// 2. 构造元素：槽位归本生产者独占，构造失败时归还
+	try {
+		data_[index].construct(std::forward<Args>(args)...);
+	}
+	catch (...) {
+		free_.enqueue(index);
+		throw;
+	}
+
+	// 3. 发布下标
+	ready_.enqueue(index);
+	return true;
+}
+
+template <typename T>
+bool lfq_array_faa<T>::dequeue(T& value) {
+	// 1. 取得已就绪的槽位
+	uint64_t index;
+	if (!ready_.dequeue(index))
+		return false;
+
+	// 2. 读取数据并析构槽位中的元素
+	data_[index].move_to(value);
+
+	// 3. 归还槽位
+	free_.enqueue(index);
+	return true;
+}
+
+template <typename T>
+bool lfq_array_faa<T>::empty() const {
+	// 松散判空，只作参考
+	return ready_.empty();
+}
@@ -0,0 +1,91 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include <stdexcept>
+
+#include "lfq_common.h"
+#include "lfq_traits.h"
+#include "lfq_seq_ring.h"
+
+// 有界多生产者多消费者队列（Dmitry Vyukov 的有界 MPMC 设计）
+// 每个槽位带一个序号 seq，代替 ready 标志，协议见 lfq_seq_ring.h（与 lfq_shm 共用）
+// 生产者与消费者都只用一次 CAS 认领槽位
+// 容量向上取整为2的幂；槽位为未初始化存储，入队时原地构造、出队时析构
+template <typename T>
+class lfq_array_seq {
+public:
+	explicit lfq_array_seq(size_t capacity);
+
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	bool dequeue(T& value);
+
+	bool empty() const;
+
+	size_t capacity() const { return mask_ + 1; }
+
+	// 析构队列中剩余的元素
+	~lfq_array_seq();
+
+private:
+	using Slot = typename lfq_seq_ring<T>::slot_type;
+
+	const size_t mask_;					// 容量掩码
+	std::unique_ptr<Slot[]> buffer_;	// 槽位数组
+	alignas(64) std::atomic<uint64_t> head_;	// 消费者序号
+	alignas(64) std::atomic<uint64_t> tail_;	// 生产者序号
+	lfq_seq_ring<T> ring_;				// 作用于以上槽位与计数器的协议
+};
+
+template <typename T>
+lfq_array_seq<T>::lfq_array_seq(size_t capacity)
+	: mask_(lfq_round_up_pow2(capacity) - 1),
+	buffer_(new Slot[mask_ + 1]),
+	head_(0),
+	tail_(0),
+	ring_(buffer_.get(), mask_, head_, tail_) {
+	if (capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+	ring_.reset();
+}
+
+template <typename T>
+lfq_array_seq<T>::~lfq_array_seq() {
+	ring_.destroy_remaining();
+}
+
+template <typename T>
+bool lfq_array_seq<T>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T>
+bool lfq_array_seq<T>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+bool lfq_array_seq<T>::emplace(Args&&... args) {
+	return ring_.emplace(std::forward<Args>(args)...);
+}
+
+template <typename T>
+bool lfq_array_seq<T>::dequeue(T& value) {
+	return ring_.dequeue(value);
+}
+
+template <typename T>
+bool lfq_array_seq<T>::empty() const {
+	// 松散判空，只作参考
+	return ring_.empty();
+}
@@ -0,0 +1,132 @@
+#pragma once
+
+#include <cstdint>
+#include <thread>
+
+#include "lfq_common.h"
+
+// head/tail 的 CAS 失败后如何退避：Traits::backoff_policy 选择
+// 跨操作的状态放在 state 中，lfq_array_based 持有一份，每次入队/出队用它在栈上创建一个策略对象
+//   bool retry()    CAS 失败后调用，按策略等待；让出了时间片时返回 true（计入 lfq_stat::backoff_yield）
+//   void success()  CAS 成功后调用
+// 不退避时失败的线程立即重试，多个生产者反复争抢 tail 所在的缓存行，竞争越激烈成功率越低
+//   lfq_no_backoff               默认，立即重试
+//   lfq_exp_backoff<Min, Max>    指数退避，状态只在一次操作内有效
+//   lfq_adaptive_backoff<Shift>  按线程在该队列上最近的失败情况决定首次退避的长度
+
+// 每个线程一个 xorshift 状态，给退避时长加随机扰动，避免同时失败的线程又同时重试
+inline uint32_t lfq_backoff_jitter() noexcept {
+	thread_local uint32_t state = static_cast<uint32_t>(
+		reinterpret_cast<uintptr_t>(&state) >> 4) | 1u;
+	state ^= state << 13;
+	state ^= state >> 17;
+	state ^= state << 5;
+	return state;
+}
+
+// pause 在 [spins / 2, spins] 中随机的次数
+inline void lfq_backoff_spin(unsigned spins) noexcept {
+	unsigned const half = spins / 2;
+	unsigned const n = half + lfq_backoff_jitter() % (spins - half + 1);
+	for (unsigned i = 0; i < n; ++i)
+		lfq_cpu_relax();
+}
+
+// 不退避
+struct lfq_no_backoff {
+	static constexpr bool enabled = false;
+
+	struct state {};
+
+	lfq_no_backoff() noexcept = default;
+
+	explicit lfq_no_backoff(state&) noexcept {}
+
+	bool retry() noexcept { return false; }
+
+	void success() noexcept {}
+};
+
+// 指数退避：第 k 次失败后约 pause MinSpins * 2^(k-1) 次，超过 MaxSpins 后每次失败都让出时间片
+template <unsigned MinSpins = 4, unsigned MaxSpins = 1024>
+class lfq_exp_backoff {
+	static_assert(MinSpins >= 1 && MinSpins <= MaxSpins, "Backoff requires 1 <= MinSpins <= MaxSpins.");
+	static_assert(MaxSpins <= (1u << 30), "MaxSpins is too large.");
+
+public:
+	static constexpr bool enabled = true;
+
+	struct state {};
+
+	lfq_exp_backoff() noexcept = default;
+
+	explicit lfq_exp_backoff(state&) noexcept {}
+
+	bool retry() noexcept {
+		if (spins_ > MaxSpins) {
+			std::this_thread::yield();
+			return true;
+		}
+		lfq_backoff_spin(spins_);
+		spins_ *= 2;
+		return false;
+	}
+
+	void success() noexcept {}
+
+private:
+	unsigned spins_ = MinSpins;
+};
+
+// 自适应退避：每个线程在每个队列上一个退避级别，存放在队列持有的 state 中
+// 一个队列上的竞争不会让同一线程在另一个队列上一开始就等待很久
+// 每次失败级别加一，一次操作没有失败时减一，级别随最近的失败率升降
+// 重试前约 pause 2^级别 次：竞争持续时第一次重试就等待较久，竞争消失后逐次回落到几乎不等待
+// 级别达到 MaxShift 后继续失败则让出时间片
+// 同时存活的队列过多、state 取不到线程局部表项时，级别只在一次操作内有效
+template <unsigned MaxShift = 10>
+class lfq_adaptive_backoff {
+	static_assert(MaxShift <= 30, "MaxShift is too large.");
+
+public:
+	static constexpr bool enabled = true;
+
+	using state = lfq_local_cache<lfq_adaptive_backoff, unsigned>;
+
+	explicit lfq_adaptive_backoff(state& s) : level_(s.find()) {
+		if (level_ == nullptr)
+			level_ = s.store(0);
+		if (level_ == nullptr)
+			level_ = &fallback_;
+	}
+
+	lfq_adaptive_backoff(const lfq_adaptive_backoff&) = delete;
+	lfq_adaptive_backoff& operator=(const lfq_adaptive_backoff&) = delete;
+
+	bool retry() noexcept {
+		failed_ = true;
+		if (*level_ >= MaxShift) {
+			std::this_thread::yield();
+			return true;
+		}
+		lfq_backoff_spin(1u << *level_);
+		++*level_;
+		return false;
+	}
+
+	void success() noexcept {
+		if (!failed_ && *level_ > 0)
+			--*level_;
+	}
+
+	// 当前线程在 s 所属队列上的退避级别
+	static unsigned level(const state& s) noexcept {
+		unsigned const* level = s.find();
+		return level ? *level : 0;
+	}
+
+private:
+	unsigned* level_;			// 本线程在该队列上的级别
+	unsigned fallback_ = 0;		// 没有表项时只在本次操作内使用
+	bool failed_ = false;		// 本次操作是否失败过
+};
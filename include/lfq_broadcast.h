@@ -0,0 +1,246 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <limits>
+#include <vector>
+#include <initializer_list>
+
+#include <stdexcept>
+#include <cassert>
+
+#include "lfq_common.h"
+#include "lfq_traits.h"
+#include "lfq_storage.h"
+
+// 广播环形队列（Disruptor 风格）：生产者只写一次，每个注册的消费者按各自的游标读取全部元素
+// 生产者 CAS 认领序号，写入后在槽位上发布 seq = 序号 + 1；多个生产者可并发写入
+// 每个消费者有独立的游标（下一个要读取的序号），处理完一批后只发布一次
+// 消费者可声明依赖（屏障）：只读取所依赖的消费者都已处理完的元素，例如 持久化 -> 风控
+// 生产者受最慢的消费者门控：只需检查没有被其他消费者依赖的"末端"消费者，依赖链上游必然不慢于下游
+// 元素在槽位中保留到下一圈覆盖时才析构，消费者通过 const 引用读取，不产生拷贝
+// 消费者必须在第一次入队之前注册；每个消费者编号同一时刻只能由一个线程使用
+// 没有消费者时入队总是成功，元素被后续入队覆盖
+template <typename T>
+class lfq_broadcast {
+public:
+	explicit lfq_broadcast(size_t capacity);
+
+	lfq_broadcast(const lfq_broadcast&) = delete;
+	lfq_broadcast& operator=(const lfq_broadcast&) = delete;
+
+	// 注册消费者，返回消费者编号；after 为其依赖的消费者编号（必须已注册）
+	size_t add_consumer(std::initializer_list<size_t> after = {});
+
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	// 批量处理：对至多 max 个可读元素依次调用 handler(const T&)，之后只发布一次游标
+	// 返回处理的个数
+	template <typename Handler>
+	size_t consume(size_t consumer, Handler&& handler, size_t max = std::numeric_limits<size_t>::max());
+
+	// 读取一个元素（拷贝赋值给 value）
+	bool dequeue(size_t consumer, T& value);
+
+	// 该消费者当前没有可读元素（松散判断，只作参考）
+	bool empty(size_t consumer) const;
+
+	size_t capacity() const { return mask_ + 1; }
+
+	size_t consumers() const { return readers_.size(); }
+
+	// 析构槽位中保留的元素
+	~lfq_broadcast();
+
+private:
+	struct Slot {
+		std::atomic<uint64_t> seq;	// 已发布的序号 + 1，0 表示从未写入
+		lfq_storage<T> data;		// 未初始化存储
+	};
+
+	struct alignas(64) reader {
+		std::atomic<uint64_t> cursor{ 0 };	// 下一个要读取的序号（之前的元素都已处理完）
+		std::vector<size_t> after;			// 依赖的消费者，注册后不再改变
+		bool gating = true;					// 没有被其他消费者依赖，参与生产者门控
+	};
+
+	// 消费者 c 从 cursor 起最多可读到的序号（不含）
+	uint64_t available(const reader& r, uint64_t cursor, size_t max) const;
+
+	// 末端消费者的最小游标；没有消费者时为 tail
+	uint64_t slowest(uint64_t tail) const;
+
+	const size_t mask_;					// 容量掩码
+	std::unique_ptr<Slot[]> buffer_;	// 槽位数组
+	std::vector<std::unique_ptr<reader>> readers_;	// 消费者
+	std::vector<reader*> gating_;					// 末端消费者
+	alignas(64) std::atomic<uint64_t> tail_;		// 生产者序号
+	alignas(64) std::atomic<uint64_t> gate_cache_;	// 最近一次计算的最慢游标，生产者共享
+};
+
+template <typename T>
+lfq_broadcast<T>::lfq_broadcast(size_t capacity)
+	: mask_(lfq_round_up_pow2(capacity) - 1),
+	buffer_(new Slot[mask_ + 1]),
+	tail_(0),
+	gate_cache_(0) {
+	if (capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+	for (size_t i = 0; i <= mask_; ++i) {
+		buffer_[i].seq.store(0, std::memory_order_relaxed);
+	}
+}
+
+template <typename T>
+lfq_broadcast<T>::~lfq_broadcast() {
+	for (size_t i = 0; i <= mask_; ++i) {
+		if (buffer_[i].seq.load(std::memory_order_acquire) != 0)
+			buffer_[i].data.destroy();
+	}
+}
+
+template <typename T>
+size_t lfq_broadcast<T>::add_consumer(std::initializer_list<size_t> after) {
+	if (tail_.load(std::memory_order_relaxed) != 0) {
+		throw std::logic_error("Consumers must be registered before the first enqueue.");
+	}
+
+	std::unique_ptr<reader> r(new reader);
+	for (size_t dep : after) {
+		if (dep >= readers_.size()) {
+			throw std::invalid_argument("Unknown consumer dependency.");
+		}
+		r->after.push_back(dep);
+	}
+
+	// 被依赖的消费者不再参与门控
+	for (size_t dep : after)
+		readers_[dep]->gating = false;
+	readers_.push_back(std::move(r));
+
+	gating_.clear();
+	for (auto& each : readers_) {
+		if (each->gating)
+			gating_.push_back(each.get());
+	}
+	return readers_.size() - 1;
+}
+
+template <typename T>
+bool lfq_broadcast<T>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T>
+bool lfq_broadcast<T>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T>
+uint64_t lfq_broadcast<T>::slowest(uint64_t tail) const {
+	uint64_t min = tail;
+	for (const reader* r : gating_) {
+		uint64_t const cursor = r->cursor.load(std::memory_order_acquire);
+		if (cursor < min)
+			min = cursor;
+	}
+	return min;
+}
+
+template <typename T>
+template <typename... Args>
+bool lfq_broadcast<T>::emplace(Args&&... args) {
+	uint64_t const capacity = mask_ + 1;
+	uint64_t tail = tail_.load(std::memory_order_relaxed);
+
+	// 1. 认领序号：与最慢的消费者相差不足一圈
+	for (;;) {
+		// 先用缓存的最慢游标判断，显示已满时才扫描各消费者的游标
+		if (tail - gate_cache_.load(std::memory_order_acquire) >= capacity) {
+			uint64_t const gate = slowest(tail);
+			gate_cache_.store(gate, std::memory_order_release);
+			if (tail - gate >= capacity)
+				return false; // 最慢的消费者尚未读完上一圈
+		}
+
+		if (tail_.compare_exchange_weak(tail, tail + 1, std::memory_order_relaxed))
+			break;
+	}
+
+	// 2. 覆盖上一圈的元素：所有消费者都已读过；等待上一圈的生产者写完（没有消费者时可能尚未发布）
+	Slot& slot = buffer_[tail & mask_];
+	if (tail >= capacity) {
+		unsigned spins = 0;
+		while (slot.seq.load(std::memory_order_acquire) != tail - capacity + 1)
+			lfq_spin_wait(spins);
+		slot.data.destroy();
+	}
+	slot.data.construct(std::forward<Args>(args)...);
+
+	// 3. 发布
+	slot.seq.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+uint64_t lfq_broadcast<T>::available(const reader& r, uint64_t cursor, size_t max) const {
+	uint64_t limit = max >= std::numeric_limits<uint64_t>::max() - cursor ? std::numeric_limits<uint64_t>::max() : cursor + max;
+
+	// 有依赖时：依赖方已处理完的元素必然已发布，不必再逐个检查
+	if (!r.after.empty()) {
+		for (size_t dep : r.after) {
+			uint64_t const c = readers_[dep]->cursor.load(std::memory_order_acquire);
+			if (c < limit)
+				limit = c;
+		}
+		return limit > cursor ? limit : cursor;
+	}
+
+	// 没有依赖：多个生产者乱序完成，只能读到连续发布的部分
+	uint64_t end = cursor;
+	while (end < limit && buffer_[end & mask_].seq.load(std::memory_order_acquire) == end + 1)
+		++end;
+	return end;
+}
+
+template <typename T>
+template <typename Handler>
+size_t lfq_broadcast<T>::consume(size_t consumer, Handler&& handler, size_t max) {
+	assert(consumer < readers_.size());
+	reader& r = *readers_[consumer];
+
+	// 游标只有本消费者写，relaxed 读取即可
+	uint64_t const cursor = r.cursor.load(std::memory_order_relaxed);
+	uint64_t const end = available(r, cursor, max);
+	if (end == cursor)
+		return 0;
+
+	for (uint64_t s = cursor; s != end; ++s) {
+		const T& value = *buffer_[s & mask_].data.get();
+		handler(value);
+	}
+
+	// 一次发布整批：生产者与下游消费者据此前进
+	r.cursor.store(end, std::memory_order_release);
+	return static_cast<size_t>(end - cursor);
+}
+
+template <typename T>
+bool lfq_broadcast<T>::dequeue(size_t consumer, T& value) {
+	return consume(consumer, [&value](const T& v) { value = v; }, 1) == 1;
+}
+
+template <typename T>
+bool lfq_broadcast<T>::empty(size_t consumer) const {
+	assert(consumer < readers_.size());
+	const reader& r = *readers_[consumer];
+	uint64_t const cursor = r.cursor.load(std::memory_order_relaxed);
+	return available(r, cursor, 1) == cursor;
+}
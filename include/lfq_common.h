@@ -0,0 +1,143 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 缓存行大小（x86 为64字节；相邻行预取时按128字节隔离更稳妥）
+constexpr size_t lfq_cache_line = 64;
+
+// 自旋等待时提示CPU降低功耗并让出流水线
+inline void lfq_cpu_relax() {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+	_mm_pause();
+#elif defined(__x86_64__) || defined(__i386__)
+	__builtin_ia32_pause();
+#elif defined(__aarch64__) || defined(__arm__)
+	asm volatile("yield");
+#endif
+}
+
+// 短暂自旋，超过阈值后让出时间片（避免在单核或被抢占时空转）
+inline void lfq_spin_wait(unsigned& spins) {
+	if (++spins < 128) {
+		lfq_cpu_relax();
+	}
+	else {
+		spins = 0;
+		std::this_thread::yield();
+	}
+}
+
+// 最低位的1所在的位置（x 不能为0）
+inline unsigned lfq_ctz64(uint64_t x) {
+#if defined(_MSC_VER) && defined(_M_X64)
+	unsigned long idx;
+	_BitScanForward64(&idx, x);
+	return static_cast<unsigned>(idx);
+#elif defined(__GNUC__) || defined(__clang__)
+	return static_cast<unsigned>(__builtin_ctzll(x));
+#else
+	unsigned n = 0;
+	while ((x & 1) == 0) {
+		x >>= 1;
+		++n;
+	}
+	return n;
+#endif
+}
+
+// 按对象缓存的线程局部数据（如每个线程在某个队列上的统计块、纪元记录）
+// 每个对象取得一个稠密下标，线程在固定长度的 thread_local 表中按下标直接找到自己的数据，命中时没有查找
+// 下标在对象析构后复用；表项同时记录对象编号（从1开始，不会复用），编号不符即未命中，不会用到已析构对象的数据
+// 表项不随对象析构删除，但表长固定，线程先后用过再多对象也不会增长
+// 同时存活的对象超过 Slots 个时，多出的对象没有下标，find() 总是返回 nullptr，由调用方走慢路径
+// Tag 区分不同用途，各自有独立的下标池与表
+template <typename Tag, typename Value, size_t Slots = 256>
+class lfq_local_cache {
+public:
+	lfq_local_cache() : id_(next_id().fetch_add(1, std::memory_order_relaxed)), index_(acquire_index()) {}
+
+	lfq_local_cache(const lfq_local_cache&) = delete;
+	lfq_local_cache& operator=(const lfq_local_cache&) = delete;
+
+	~lfq_local_cache() { release_index(index_); }
+
+	// 本线程为该对象缓存的值，没有时返回 nullptr
+	Value* find() const noexcept {
+		if (index_ >= Slots)
+			return nullptr;
+		entry& e = table()[index_];
+		return e.owner == id_ ? &e.value : nullptr;
+	}
+
+	// 缓存本线程的值，覆盖同一下标上已析构对象留下的表项；没有下标时不缓存，返回 nullptr
+	Value* store(Value value) {
+		if (index_ >= Slots)
+			return nullptr;
+		entry& e = table()[index_];
+		e.value = std::move(value);
+		e.owner = id_;
+		return &e.value;
+	}
+
+	uint64_t id() const noexcept { return id_; }
+
+private:
+	struct entry {
+		uint64_t owner = 0;
+		Value value{};
+	};
+
+	struct index_pool {
+		std::mutex mutex;
+		std::vector<size_t> free;
+		size_t next = 0;
+	};
+
+	static entry* table() noexcept {
+		thread_local entry t[Slots];
+		return t;
+	}
+
+	static std::atomic<uint64_t>& next_id() {
+		static std::atomic<uint64_t> id{ 1 };
+		return id;
+	}
+
+	static index_pool& pool() {
+		static index_pool p;
+		return p;
+	}
+
+	// 只在对象构造/析构时加锁
+	static size_t acquire_index() {
+		index_pool& p = pool();
+		std::lock_guard<std::mutex> lock(p.mutex);
+		if (!p.free.empty()) {
+			size_t const i = p.free.back();
+			p.free.pop_back();
+			return i;
+		}
+		return p.next < Slots ? p.next++ : Slots;
+	}
+
+	static void release_index(size_t index) {
+		if (index >= Slots)
+			return;
+		index_pool& p = pool();
+		std::lock_guard<std::mutex> lock(p.mutex);
+		p.free.push_back(index);
+	}
+
+	const uint64_t id_;
+	const size_t index_;
+};
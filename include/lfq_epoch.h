@@ -0,0 +1,199 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <memory>
+
+#include "lfq_common.h"
+
+// 基于纪元（epoch）的延迟回收
+// 每次访问共享节点前 pin() 登记当前纪元，guard 析构时退出
+// 节点摘除后 retire()，只有全局纪元前进两次之后（此前登记的线程都已退出）才交给回收函数
+// Node 需提供两个侵入式成员：Node* retired_next; uint64_t retired_epoch;
+// 线程首次进入时认领一条登记记录并独占它，之后经 lfq_local_cache 直接找到
+// 进入临界区只需写一次自己的记录再加一道全栅栏（标准 EBR），不做原子读改写；线程退出时归还记录供其他线程复用
+// 同时存活的域过多（没有缓存下标）或同一线程嵌套进入时，退回按操作临时认领一条记录
+template <typename Node>
+class lfq_epoch_domain {
+	struct alignas(lfq_cache_line) record {
+		std::atomic<uint64_t> state{ 0 };		// 0 表示不在临界区，否则为 (纪元 << 1) | 1
+		std::atomic<bool> owned{ false };		// 已被某个线程独占（或临时认领）
+		record* next = nullptr;
+		std::shared_ptr<record> self;			// 域持有的引用，域析构时放开
+	};
+
+	// 线程局部表中的独占记录：线程退出或表项被覆盖时归还
+	// 与域共同持有记录，域先析构时记录仍有效
+	class owner {
+	public:
+		owner() = default;
+		explicit owner(std::shared_ptr<record> rec) : rec_(std::move(rec)) {}
+		owner(owner&& other) noexcept : rec_(std::move(other.rec_)) {}
+		owner& operator=(owner&& other) noexcept {
+			if (this != &other) {
+				release();
+				rec_ = std::move(other.rec_);
+			}
+			return *this;
+		}
+		~owner() { release(); }
+
+		record* get() const noexcept { return rec_.get(); }
+
+	private:
+		void release() noexcept {
+			if (rec_) {
+				rec_->owned.store(false, std::memory_order_release);
+				rec_.reset();
+			}
+		}
+
+		std::shared_ptr<record> rec_;
+	};
+
+public:
+	class guard {
+	public:
+		guard(record* rec, bool temporary) : rec_(rec), temporary_(temporary) {}
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+		~guard() {
+			rec_->state.store(0, std::memory_order_release);
+			if (temporary_)
+				rec_->owned.store(false, std::memory_order_release);
+		}
+
+	private:
+		record* rec_;
+		bool temporary_;	// 按操作临时认领，退出时归还
+	};
+
+	lfq_epoch_domain() = default;
+
+	lfq_epoch_domain(const lfq_epoch_domain&) = delete;
+	lfq_epoch_domain& operator=(const lfq_epoch_domain&) = delete;
+
+	// 此时不应再有并发操作；尚未回收的节点须先由 clear() 取走
+	// 仍被线程局部表引用的记录在线程退出时释放
+	~lfq_epoch_domain() {
+		record* rec = records_.load(std::memory_order_acquire);
+		while (rec) {
+			record* next = rec->next;
+			std::shared_ptr<record> drop = std::move(rec->self);
+			rec = next;
+		}
+	}
+
+	// 进入临界区：guard 存活期间读到的节点不会被回收
+	guard pin() {
+		// 1. 本线程独占的记录；嵌套进入时该记录已在临界区，改用临时记录
+		record* rec = nullptr;
+		bool temporary = false;
+		if (owner* own = cache_.find()) {
+			rec = own->get();
+			if (rec->state.load(std::memory_order_relaxed) != 0) {
+				rec = claim_record();
+				temporary = true;
+			}
+		}
+		else {
+			rec = claim_record();
+			temporary = cache_.store(owner(rec->self)) == nullptr;
+		}
+
+		// 2. 登记当前纪元，全栅栏保证之后读取的节点指针不早于登记（与 try_advance 的扫描配对）
+		rec->state.store((epoch_.load(std::memory_order_relaxed) << 1) | 1, std::memory_order_relaxed);
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		return guard(rec, temporary);
+	}
+
+	// 节点已从数据结构中摘除，登记等待回收
+	void retire(Node* node) {
+		node->retired_epoch = epoch_.load(std::memory_order_seq_cst);
+		Node* top = retired_.load(std::memory_order_relaxed);
+		do {
+			node->retired_next = top;
+		} while (!retired_.compare_exchange_weak(top, node, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// 尝试推进纪元，并把已过宽限期的节点交给 dispose
+	template <typename Dispose>
+	void reclaim(Dispose&& dispose) {
+		try_advance();
+		uint64_t const epoch = epoch_.load(std::memory_order_seq_cst);
+
+		// 整体取走（避免弹出单个节点的 ABA），未到期的再放回
+		Node* node = retired_.exchange(nullptr, std::memory_order_acquire);
+		Node* keep = nullptr;
+		Node* keep_last = nullptr;
+		while (node) {
+			Node* next = node->retired_next;
+			if (node->retired_epoch + 2 <= epoch) {
+				dispose(node);
+			}
+			else {
+				node->retired_next = keep;
+				keep = node;
+				if (!keep_last)
+					keep_last = node;
+			}
+			node = next;
+		}
+
+		if (keep) {
+			Node* top = retired_.load(std::memory_order_relaxed);
+			do {
+				keep_last->retired_next = top;
+			} while (!retired_.compare_exchange_weak(top, keep, std::memory_order_release, std::memory_order_relaxed));
+		}
+	}
+
+	// 不论纪元，取走全部待回收节点（仅在没有并发操作时调用）
+	template <typename Dispose>
+	void clear(Dispose&& dispose) {
+		Node* node = retired_.exchange(nullptr, std::memory_order_acquire);
+		while (node) {
+			Node* next = node->retired_next;
+			dispose(node);
+			node = next;
+		}
+	}
+
+private:
+	// 认领一条未被占用的记录，没有时新建（只在线程首次进入、或走慢路径时调用）
+	record* claim_record() {
+		for (record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+			bool expected = false;
+			if (!rec->owned.load(std::memory_order_relaxed) &&
+				rec->owned.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return rec;
+		}
+
+		// 记录只增不减，直到域析构
+		std::shared_ptr<record> fresh = std::make_shared<record>();
+		record* rec = fresh.get();
+		rec->owned.store(true, std::memory_order_relaxed);
+		rec->self = std::move(fresh);
+		record* top = records_.load(std::memory_order_relaxed);
+		do {
+			rec->next = top;
+		} while (!records_.compare_exchange_weak(top, rec, std::memory_order_seq_cst, std::memory_order_relaxed));
+		return rec;
+	}
+
+	// 所有活跃记录都已登记当前纪元时，纪元加一
+	void try_advance() {
+		uint64_t epoch = epoch_.load(std::memory_order_seq_cst);
+		for (record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+			uint64_t const state = rec->state.load(std::memory_order_seq_cst);
+			if ((state & 1) && (state >> 1) != epoch)
+				return;
+		}
+		epoch_.compare_exchange_strong(epoch, epoch + 1, std::memory_order_seq_cst);
+	}
+
+	lfq_local_cache<lfq_epoch_domain, owner> cache_;				// 本线程独占的记录
+	alignas(lfq_cache_line) std::atomic<uint64_t> epoch_{ 1 };	// 全局纪元
+	std::atomic<Node*> retired_{ nullptr };						// 待回收节点（栈）
+	alignas(lfq_cache_line) std::atomic<record*> records_{ nullptr };	// 登记记录链表
+};
@@ -0,0 +1,187 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <vector>
+
+#include "lfq_common.h"
+
+struct lfq_hazard_no_local {};
+
+// 风险指针（hazard pointer）回收
+// 访问节点前用 guard::protect 公布它，摘除后的节点经 guard::retire 登记
+// 登记的节点积累到阈值时扫描全部风险指针，没有被任何线程公布的节点交给回收函数
+// Node 需提供侵入式成员 Node* retired_next;
+// 登记记录按操作认领（一次无竞争的 CAS），线程用 thread_local 提示优先认领上次用过的记录
+// 每个记录附带一个 Local 对象，持有该记录的线程独占访问（如节点池的本地缓存）
+template <typename Node, size_t Slots = 2, typename Local = lfq_hazard_no_local>
+class lfq_hazard_domain {
+	struct alignas(lfq_cache_line) record {
+		std::atomic<Node*> hazards[Slots] = {};
+		std::atomic<bool> active{ false };
+		record* next = nullptr;
+		Node* retired = nullptr;		// 本记录登记的待回收节点
+		size_t retired_count = 0;
+		std::vector<Node*> scratch;		// 扫描时收集风险指针，容量复用
+		Local local;
+	};
+
+public:
+	class guard {
+	public:
+		guard(lfq_hazard_domain* domain, record* rec) : domain_(domain), rec_(rec) {}
+		guard(const guard&) = delete;
+		guard& operator=(const guard&) = delete;
+
+		~guard() {
+			for (auto& hp : rec_->hazards)
+				hp.store(nullptr, std::memory_order_release);
+			rec_->active.store(false, std::memory_order_release);
+		}
+
+		// 读取 src 并公布到第 i 个风险指针，公布后 src 未变才返回，保证节点未被回收
+		Node* protect(size_t i, const std::atomic<Node*>& src) {
+			Node* p = src.load(std::memory_order_relaxed);
+			for (;;) {
+				rec_->hazards[i].store(p, std::memory_order_seq_cst);
+				Node* const again = src.load(std::memory_order_seq_cst);
+				if (again == p)
+					return p;
+				p = again;
+			}
+		}
+
+		// 直接公布（调用方负责随后验证节点仍可达）
+		void set(size_t i, Node* p) {
+			rec_->hazards[i].store(p, std::memory_order_seq_cst);
+		}
+
+		// 节点已从数据结构中摘除，登记等待回收
+		template <typename Dispose>
+		void retire(Node* node, Dispose&& dispose) {
+			node->retired_next = rec_->retired;
+			rec_->retired = node;
+			if (++rec_->retired_count >= domain_->scan_threshold())
+				domain_->scan(rec_, dispose);
+		}
+
+		Local& local() { return rec_->local; }
+
+	private:
+		lfq_hazard_domain* domain_;
+		record* rec_;
+	};
+
+	lfq_hazard_domain() : id_(next_id().fetch_add(1, std::memory_order_relaxed)) {}
+
+	lfq_hazard_domain(const lfq_hazard_domain&) = delete;
+	lfq_hazard_domain& operator=(const lfq_hazard_domain&) = delete;
+
+	// 此时不应再有并发操作；待回收节点的内存由调用方统一释放（如随节点池一起释放）
+	~lfq_hazard_domain() {
+		record* rec = records_.load(std::memory_order_acquire);
+		while (rec) {
+			record* next = rec->next;
+			delete rec;
+			rec = next;
+		}
+	}
+
+	guard acquire() {
+		thread_local hint_slot hint;
+
+		// 1. 优先认领本线程上次使用的记录
+		if (hint.domain == id_) {
+			bool expected = false;
+			if (hint.rec->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return guard(this, hint.rec);
+		}
+
+		// 2. 扫描全部记录，找不到空闲的再新建一个
+		record* rec = claim_record();
+		hint.domain = id_;
+		hint.rec = rec;
+		return guard(this, rec);
+	}
+
+	// 依次访问所有记录的 Local 对象（仅在没有并发操作时调用）
+	template <typename F>
+	void for_each_local(F&& f) {
+		for (record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next)
+			f(rec->local);
+	}
+
+private:
+	struct hint_slot {
+		uint64_t domain = 0;		// 域编号从1开始，不会复用，避免悬空的提示
+		record* rec = nullptr;
+	};
+
+	static std::atomic<uint64_t>& next_id() {
+		static std::atomic<uint64_t> id{ 1 };
+		return id;
+	}
+
+	record* claim_record() {
+		for (record* rec = records_.load(std::memory_order_acquire); rec; rec = rec->next) {
+			bool expected = false;
+			if (!rec->active.load(std::memory_order_relaxed) &&
+				rec->active.compare_exchange_strong(expected, true, std::memory_order_acquire))
+				return rec;
+		}
+
+		// 记录只增不减，直到域析构
+		record* rec = new record;
+		rec->active.store(true, std::memory_order_relaxed);
+		record* top = records_.load(std::memory_order_relaxed);
+		do {
+			rec->next = top;
+		} while (!records_.compare_exchange_weak(top, rec, std::memory_order_release, std::memory_order_relaxed));
+		record_count_.fetch_add(1, std::memory_order_relaxed);
+		return rec;
+	}
+
+	// 待回收节点超过风险指针总数的两倍时扫描，每次扫描至少回收一半
+	size_t scan_threshold() const {
+		return 2 * Slots * record_count_.load(std::memory_order_relaxed) + 16;
+	}
+
+	template <typename Dispose>
+	void scan(record* rec, Dispose& dispose) {
+		// 与 protect 中公布后的重新读取配对
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+
+		// 1. 收集所有已公布的风险指针
+		rec->scratch.clear();
+		for (record* r = records_.load(std::memory_order_acquire); r; r = r->next) {
+			for (auto& hp : r->hazards) {
+				Node* const p = hp.load(std::memory_order_seq_cst);
+				if (p)
+					rec->scratch.push_back(p);
+			}
+		}
+		std::sort(rec->scratch.begin(), rec->scratch.end());
+
+		// 2. 未被公布的节点交给 dispose，其余留待下次
+		Node* node = rec->retired;
+		rec->retired = nullptr;
+		rec->retired_count = 0;
+		while (node) {
+			Node* const next = node->retired_next;
+			if (std::binary_search(rec->scratch.begin(), rec->scratch.end(), node)) {
+				node->retired_next = rec->retired;
+				rec->retired = node;
+				++rec->retired_count;
+			}
+			else {
+				dispose(node, rec->local);
+			}
+			node = next;
+		}
+	}
+
+	const uint64_t id_;
+	alignas(lfq_cache_line) std::atomic<record*> records_{ nullptr };	// 登记记录链表
+	std::atomic<size_t> record_count_{ 0 };
+};
@@ -0,0 +1,148 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+#include "lfq_common.h"
+
+#if defined(_MSC_VER)
+#include <intrin.h>
+#endif
+
+// 入队到出队的驻留时间：Traits::latency_policy 选择
+//   lfq_no_latency                       默认，槽位不增加字段，不读时钟
+//   lfq_sampled_latency<Interval, Clock> 序号为 Interval 整数倍的元素在入队时打时间戳，出队时记入直方图
+// 采样由序号决定，生产者与消费者不需要额外的标志或线程局部状态
+
+// 时钟：steady_clock 纳秒
+struct lfq_steady_clock {
+	static uint64_t now() noexcept {
+		return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+			std::chrono::steady_clock::now().time_since_epoch()).count());
+	}
+};
+
+// 时钟：x86 TSC 周期数（开销最低，单位为周期，需自行换算）；其他平台退回 steady_clock 纳秒
+struct lfq_tsc_clock {
+	static uint64_t now() noexcept {
+#if defined(_MSC_VER) && (defined(_M_X64) || defined(_M_IX86))
+		return __rdtsc();
+#elif defined(__x86_64__) || defined(__i386__)
+		return __builtin_ia32_rdtsc();
+#else
+		return lfq_steady_clock::now();
+#endif
+	}
+};
+
+// 对数分桶直方图（HDR 风格）：小于16的值精确记录，其余按最高位分组、每组16个子桶，相对误差不超过 1/16
+// 记录为一次 relaxed fetch_add，可由其他线程随时读取；独占缓存行，不与队列的其他字段共享
+class alignas(lfq_cache_line) lfq_latency_histogram {
+public:
+	static constexpr unsigned sub_bits = 4;
+	static constexpr size_t sub_count = size_t(1) << sub_bits;
+	static constexpr size_t bucket_count = (64 - sub_bits + 1) * sub_count;
+
+	void record(uint64_t value) noexcept {
+		counts_[bucket_of(value)].fetch_add(1, std::memory_order_relaxed);
+	}
+
+	uint64_t count(size_t bucket) const noexcept {
+		return counts_[bucket].load(std::memory_order_relaxed);
+	}
+
+	static size_t bucket_of(uint64_t value) noexcept {
+		if (value < sub_count)
+			return static_cast<size_t>(value);
+		unsigned msb = 63;
+		while (!(value >> msb))
+			--msb;
+		unsigned const shift = msb - sub_bits;
+		return (msb - sub_bits + 1) * sub_count + static_cast<size_t>((value >> shift) & (sub_count - 1));
+	}
+
+	// 桶内最大值（百分位按此报告，偏保守）
+	static uint64_t bucket_upper(size_t bucket) noexcept {
+		if (bucket < sub_count)
+			return bucket;
+		unsigned const shift = static_cast<unsigned>(bucket / sub_count) - 1;
+		uint64_t const lower = static_cast<uint64_t>(sub_count + bucket % sub_count) << shift;
+		return lower + ((uint64_t(1) << shift) - 1);
+	}
+
+private:
+	std::atomic<uint64_t> counts_[bucket_count] = {};
+};
+
+// 直方图的一份拷贝，用于计算百分位
+struct lfq_latency_snapshot {
+	uint64_t counts[lfq_latency_histogram::bucket_count] = {};
+	uint64_t total = 0;
+
+	// q 取 [0, 1]，返回对应桶的上界；没有样本时返回0
+	uint64_t percentile(double q) const noexcept {
+		if (total == 0)
+			return 0;
+		uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(total - 1)) + 1;
+		for (size_t i = 0; i < lfq_latency_histogram::bucket_count; ++i) {
+			if (counts[i] >= rank)
+				return lfq_latency_histogram::bucket_upper(i);
+			rank -= counts[i];
+		}
+		return lfq_latency_histogram::bucket_upper(lfq_latency_histogram::bucket_count - 1);
+	}
+
+	uint64_t max() const noexcept { return percentile(1.0); }
+};
+
+struct lfq_no_latency {
+	static constexpr bool enabled = false;
+
+	struct slot_base {};
+
+	void on_enqueue(slot_base&, uint64_t) noexcept {}
+
+	void on_dequeue(const slot_base&, uint64_t) noexcept {}
+
+	lfq_latency_snapshot snapshot() const { return {}; }
+};
+
+template <unsigned Interval = 64, typename Clock = lfq_steady_clock>
+class lfq_sampled_latency {
+	static_assert(Interval != 0 && (Interval & (Interval - 1)) == 0, "Sampling interval must be a power of two.");
+
+public:
+	static constexpr bool enabled = true;
+
+	// 时间戳随槽位存放，由 ready 标志的 release/acquire 发布给消费者
+	struct slot_base {
+		uint64_t stamp = 0;
+	};
+
+	void on_enqueue(slot_base& slot, uint64_t seq) noexcept {
+		if ((seq & (Interval - 1)) == 0)
+			slot.stamp = Clock::now();
+	}
+
+	void on_dequeue(const slot_base& slot, uint64_t seq) noexcept {
+		if ((seq & (Interval - 1)) == 0) {
+			uint64_t const now = Clock::now();
+			// 跨核读取 TSC 可能略有倒退，按0记录
+			hist_.record(now > slot.stamp ? now - slot.stamp : 0);
+		}
+	}
+
+	lfq_latency_snapshot snapshot() const {
+		lfq_latency_snapshot r;
+		for (size_t i = 0; i < lfq_latency_histogram::bucket_count; ++i) {
+			r.counts[i] = hist_.count(i);
+			r.total += r.counts[i];
+		}
+		return r;
+	}
+
+private:
+	lfq_latency_histogram hist_;
+};
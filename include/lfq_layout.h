@@ -0,0 +1,71 @@
+#pragma once
+
+#include <cstddef>
+
+#include "lfq_common.h"
+
+// 槽位布局策略：决定槽位的对齐/填充，以及槽位下标的重排方式
+// 小类型（如 int）时多个槽位共享一条缓存行，生产者写 i 与消费者清 i-1 会争用同一行
+
+// 紧凑布局（默认）：槽位按自然对齐连续存放
+struct lfq_packed_layout {
+	static constexpr size_t align = 1;	// 额外对齐要求
+
+	// 下标映射：恒等
+	template <size_t SlotSize>
+	struct mapper {
+		explicit mapper(size_t) {}
+		size_t operator()(size_t idx) const { return idx; }
+	};
+};
+
+// 填充布局：每个槽位独占 Align 字节（64 为一条缓存行，128 可避开相邻行预取）
+template <size_t Align = lfq_cache_line>
+struct lfq_padded_layout {
+	static_assert((Align & (Align - 1)) == 0, "Alignment must be a power of two.");
+	static constexpr size_t align = Align;
+
+	template <size_t SlotSize>
+	struct mapper {
+		explicit mapper(size_t) {}
+		size_t operator()(size_t idx) const { return idx; }
+	};
+};
+
+// 重排布局：槽位仍紧凑存放，但把连续的序号分散到不同缓存行
+// 设每行容纳 E 个槽位、共 L 行，则下标 i 映射到第 (i % L) 行的第 (i / L) 个位置
+// 仅当槽位数为2的幂时生效（用位运算完成映射），否则退化为恒等映射
+struct lfq_remap_layout {
+	static constexpr size_t align = 1;
+
+	template <size_t SlotSize>
+	struct mapper {
+		explicit mapper(size_t slots) {
+			size_t per_line = 1;	// 每行槽位数，向下取整为2的幂
+			while (per_line * 2 * SlotSize <= lfq_cache_line)
+				per_line *= 2;
+
+			bool const pow2 = slots != 0 && (slots & (slots - 1)) == 0;
+			if (!pow2 || per_line == 1 || slots < per_line * 2)
+				return;
+
+			size_t const lines = slots / per_line;
+			while ((size_t(1) << line_bits_) < lines)
+				++line_bits_;
+			while ((size_t(1) << slot_bits_) < per_line)
+				++slot_bits_;
+			line_mask_ = lines - 1;
+		}
+
+		size_t operator()(size_t idx) const {
+			if (line_bits_ == 0)
+				return idx;
+			return ((idx & line_mask_) << slot_bits_) | (idx >> line_bits_);
+		}
+
+	private:
+		size_t line_mask_ = 0;
+		unsigned line_bits_ = 0;	// log2(行数)
+		unsigned slot_bits_ = 0;	// log2(每行槽位数)
+	};
+};
@@ -0,0 +1,160 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "lfq_storage.h"
+#include "lfq_hazard.h"
+#include "lfq_node_pool.h"
+
+// Michael-Scott 链表队列（MPMC，无界）
+// 带哑元头结点：head_ 指向已取走的哑元，元素位于其后继；入队 CAS 链接到 tail_->next，再推进 tail_
+// 节点经风险指针（lfq_hazard_domain）确认无人访问后回收到节点池（lfq_node_pool），快速路径不调用 new/delete
+// 出队 CAS 推进 head_ 后才移出元素，移出期间新的哑元节点由风险指针保护，元素不会被并发拷贝
+// 构造参数为预分配的节点数
+template <typename T>
+class lfq_linked {
+public:
+	explicit lfq_linked(size_t reserve = 0);
+
+	lfq_linked(const lfq_linked&) = delete;
+	lfq_linked& operator=(const lfq_linked&) = delete;
+
+	// 总是成功，返回 bool 以便与有界队列互换
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	bool dequeue(T& value);
+
+	bool empty() const;
+
+	// 析构队列中剩余的元素，节点内存随节点池一起释放
+	~lfq_linked();
+
+private:
+	struct Node {
+		lfq_storage<T> data;				// 哑元节点中没有元素
+		std::atomic<Node*> next{ nullptr };
+		Node* retired_next = nullptr;		// 风险指针待回收链表
+		Node* pool_next = nullptr;			// 节点池空闲链表
+	};
+	using pool_type = lfq_node_pool<Node>;
+	using hazard_type = lfq_hazard_domain<Node, 2, typename pool_type::cache>;
+
+	pool_type pool_;
+	mutable hazard_type hazards_;
+	alignas(64) std::atomic<Node*> head_;	// 哑元节点
+	alignas(64) std::atomic<Node*> tail_;	// 最后一个节点（可能落后一步）
+};
+
+template <typename T>
+lfq_linked<T>::lfq_linked(size_t reserve)
+	: head_(nullptr),
+	tail_(nullptr) {
+	pool_.reserve(reserve + 1);
+	auto guard = hazards_.acquire();
+	Node* dummy = pool_.allocate(guard.local());
+	dummy->next.store(nullptr, std::memory_order_relaxed);
+	head_.store(dummy, std::memory_order_relaxed);
+	tail_.store(dummy, std::memory_order_relaxed);
+}
+
+template <typename T>
+lfq_linked<T>::~lfq_linked() {
+	// 此时不应再有并发操作：哑元之后的节点都持有元素
+	Node* node = head_.load(std::memory_order_acquire)->next.load(std::memory_order_acquire);
+	while (node) {
+		node->data.destroy();
+		node = node->next.load(std::memory_order_relaxed);
+	}
+}
+
+template <typename T>
+bool lfq_linked<T>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T>
+bool lfq_linked<T>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T>
+template <typename... Args>
+bool lfq_linked<T>::emplace(Args&&... args) {
+	auto guard = hazards_.acquire();
+
+	// 1. 从本地缓存取节点并构造元素
+	Node* node = pool_.allocate(guard.local());
+	node->next.store(nullptr, std::memory_order_relaxed);
+	node->data.construct(std::forward<Args>(args)...);
+
+	for (;;) {
+		Node* tail = guard.protect(0, tail_);
+		Node* next = tail->next.load(std::memory_order_acquire);
+		if (tail != tail_.load(std::memory_order_acquire))
+			continue;
+
+		// tail_ 落后：帮助推进
+		if (next != nullptr) {
+			tail_.compare_exchange_strong(tail, next, std::memory_order_release, std::memory_order_relaxed);
+			continue;
+		}
+
+		// 2. 链接到末尾，再尝试推进 tail_（失败说明已被其他线程推进）
+		if (tail->next.compare_exchange_weak(next, node, std::memory_order_release, std::memory_order_relaxed)) {
+			tail_.compare_exchange_strong(tail, node, std::memory_order_release, std::memory_order_relaxed);
+			return true;
+		}
+	}
+}
+
+template <typename T>
+bool lfq_linked<T>::dequeue(T& value) {
+	auto guard = hazards_.acquire();
+
+	for (;;) {
+		Node* head = guard.protect(0, head_);
+		Node* tail = tail_.load(std::memory_order_acquire);
+		Node* next = head->next.load(std::memory_order_acquire);
+
+		// 公布 next 后确认 head 仍是哑元，此时 next 尚未被摘除
+		guard.set(1, next);
+		if (head != head_.load(std::memory_order_seq_cst))
+			continue;
+
+		if (next == nullptr) {
+			return false; // 队列为空
+		}
+
+		// tail_ 落后：帮助推进，保证被摘除的节点不再被 tail_ 引用
+		if (head == tail) {
+			tail_.compare_exchange_strong(tail, next, std::memory_order_release, std::memory_order_relaxed);
+			continue;
+		}
+
+		// 1. 认领：next 成为新的哑元，只有 CAS 成功的消费者取它的元素
+		if (head_.compare_exchange_weak(head, next, std::memory_order_acq_rel, std::memory_order_relaxed)) {
+			// 2. 移出元素（next 受风险指针保护）
+			next->data.move_to(value);
+
+			// 3. 旧的哑元等待回收
+			guard.retire(head, [this](Node* n, typename pool_type::cache& local) {
+				pool_.deallocate(local, n);
+				});
+			return true;
+		}
+	}
+}
+
+template <typename T>
+bool lfq_linked<T>::empty() const {
+	// 松散判空，只作参考
+	auto guard = hazards_.acquire();
+	Node* head = guard.protect(0, head_);
+	return head->next.load(std::memory_order_relaxed) == nullptr;
+}
@@ -0,0 +1,118 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+
+// 节点池：按块（ChunkSize 个节点）向系统申请内存，节点只在池内循环，直到池析构才释放
+// 每个使用者持有一个本地缓存（cache），分配/归还都在本地链表上完成，不含原子操作
+// 本地缓存过多时把一批节点推入共享栈，本地用尽时整体取走共享栈，不足再申请新块
+// 共享栈只有整体 exchange 与推入两种操作，不存在弹出单个节点时的 ABA
+// Node 需提供侵入式成员 Node* pool_next; 且可平凡析构（元素由使用者自行构造/析构）
+template <typename Node, size_t ChunkSize = 256>
+class lfq_node_pool {
+	static_assert(ChunkSize > 0, "Chunk size must be greater than zero.");
+
+public:
+	struct cache {
+		Node* head = nullptr;
+		size_t count = 0;
+	};
+
+	lfq_node_pool() = default;
+
+	lfq_node_pool(const lfq_node_pool&) = delete;
+	lfq_node_pool& operator=(const lfq_node_pool&) = delete;
+
+	// 释放全部块，此时不应再有节点在使用
+	~lfq_node_pool() {
+		chunk* c = chunks_.load(std::memory_order_acquire);
+		while (c) {
+			chunk* next = c->next;
+			delete c;
+			c = next;
+		}
+	}
+
+	// 预先申请至少 n 个节点放入共享栈
+	void reserve(size_t n) {
+		for (size_t have = 0; have < n; have += ChunkSize) {
+			Node* first = new_chunk();
+			push_shared(first, &first[ChunkSize - 1]);
+		}
+	}
+
+	Node* allocate(cache& local) {
+		if (!local.head)
+			refill(local);
+		Node* node = local.head;
+		local.head = node->pool_next;
+		--local.count;
+		return node;
+	}
+
+	void deallocate(cache& local, Node* node) {
+		node->pool_next = local.head;
+		local.head = node;
+		// 本地节点达到两块时把其中一块交给共享栈，供只分配不归还的线程（如生产者）使用
+		if (++local.count >= 2 * ChunkSize)
+			flush(local, ChunkSize);
+	}
+
+private:
+	struct chunk {
+		chunk* next = nullptr;
+		Node nodes[ChunkSize];
+	};
+
+	void refill(cache& local) {
+		// 1. 整体取走共享栈
+		Node* list = shared_.exchange(nullptr, std::memory_order_acquire);
+		if (list) {
+			size_t n = 0;
+			for (Node* p = list; p; p = p->pool_next)
+				++n;
+			local.head = list;
+			local.count = n;
+			return;
+		}
+
+		// 2. 申请新块
+		local.head = new_chunk();
+		local.count = ChunkSize;
+	}
+
+	// 申请一块并串成链表，返回第一个节点
+	Node* new_chunk() {
+		chunk* c = new chunk;
+		for (size_t i = 0; i + 1 < ChunkSize; ++i)
+			c->nodes[i].pool_next = &c->nodes[i + 1];
+		c->nodes[ChunkSize - 1].pool_next = nullptr;
+
+		chunk* top = chunks_.load(std::memory_order_relaxed);
+		do {
+			c->next = top;
+		} while (!chunks_.compare_exchange_weak(top, c, std::memory_order_release, std::memory_order_relaxed));
+		return &c->nodes[0];
+	}
+
+	void push_shared(Node* first, Node* last) {
+		Node* top = shared_.load(std::memory_order_relaxed);
+		do {
+			last->pool_next = top;
+		} while (!shared_.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+	}
+
+	// 把本地链表的前 n 个节点推入共享栈
+	void flush(cache& local, size_t n) {
+		Node* first = local.head;
+		Node* last = first;
+		for (size_t i = 1; i < n; ++i)
+			last = last->pool_next;
+		local.head = last->pool_next;
+		local.count -= n;
+		push_shared(first, last);
+	}
+
+	alignas(64) std::atomic<Node*> shared_{ nullptr };	// 共享空闲节点
+	std::atomic<chunk*> chunks_{ nullptr };				// 已申请的块，析构时释放
+};
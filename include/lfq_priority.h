@@ -0,0 +1,189 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+#include <stdexcept>
+#include <cassert>
+
+#include "lfq_common.h"
+#include "lfq_array_based.h"
+
+// 多优先级队列：Levels 条 lfq_array_based 通道，0 为最高优先级
+// 生产者按优先级入队到对应通道，彼此独立，紧急消息不会排在大批量数据之后
+// 非空位图 nonempty_ 的第 i 位表示通道 i 可能有数据，消费者只访问位图中置位的通道：
+//   生产者发布元素后，若该位未置位则置位
+//   消费者在通道取空时清位，清位后再尝试一次，避免与刚发布的生产者错过
+// 出队策略：
+//   严格优先级（weights 为空）：总是取置位的最高优先级通道
+//   加权轮询：通道 i 每轮最多连续取 weights[i] 个，低优先级通道不会被饿死
+// 出队端只允许单消费者（轮询状态不加锁）
+template <typename T, size_t Levels, typename Traits = lfq_default_traits>
+class lfq_priority {
+	static_assert(Levels > 0 && Levels <= 64, "Levels must be in [1, 64].");
+
+public:
+	using lane_type = lfq_array_based<T, Traits>;
+
+	// weights 为空时按严格优先级出队，否则长度必须为 Levels 且每项大于0
+	explicit lfq_priority(size_t lane_capacity, std::vector<unsigned> weights = {});
+
+	lfq_priority(const lfq_priority&) = delete;
+	lfq_priority& operator=(const lfq_priority&) = delete;
+
+	bool enqueue(size_t level, const T& value);
+
+	bool enqueue(size_t level, T&& value);
+
+	template <typename... Args>
+	bool emplace(size_t level, Args&&... args);
+
+	bool dequeue(T& value);
+
+	bool empty() const;
+
+	// 单个通道的容量
+	size_t capacity() const { return lanes_[0]->capacity(); }
+
+	static constexpr size_t levels() { return Levels; }
+
+	// 访问单个通道（统计、关闭等）；直接从通道出队不会维护位图，只会使位图多出过期的置位
+	lane_type& lane(size_t level) { return *lanes_[level]; }
+
+private:
+	// 生产者发布后确保该通道的位已置位
+	void mark(size_t level);
+
+	// 尝试从通道出队；取空时清位并复查
+	bool take(size_t level, T& value);
+
+	std::array<std::unique_ptr<lane_type>, Levels> lanes_;	// 各优先级通道
+	std::array<unsigned, Levels> weights_{};				// 每轮配额，全0表示严格优先级
+	const bool weighted_;
+	alignas(64) std::atomic<uint64_t> nonempty_{ 0 };	// 非空位图
+	alignas(64) size_t current_ = 0;	// 加权轮询当前通道（仅消费者访问）
+	unsigned credit_ = 0;				// 当前通道本轮剩余配额
+};
+
+template <typename T, size_t Levels, typename Traits>
+lfq_priority<T, Levels, Traits>::lfq_priority(size_t lane_capacity, std::vector<unsigned> weights)
+	: weighted_(!weights.empty()) {
+	if (lane_capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+	if (weighted_) {
+		if (weights.size() != Levels) {
+			throw std::invalid_argument("Weights must have one entry per level.");
+		}
+		for (size_t i = 0; i < Levels; ++i) {
+			if (weights[i] == 0) {
+				throw std::invalid_argument("Weights must be greater than zero.");
+			}
+			weights_[i] = weights[i];
+		}
+		credit_ = weights_[0];
+	}
+	for (auto& lane : lanes_)
+		lane.reset(new lane_type(lane_capacity));
+}
+
+template <typename T, size_t Levels, typename Traits>
+bool lfq_priority<T, Levels, Traits>::enqueue(size_t level, const T& value) {
+	return emplace(level, value);
+}
+
+template <typename T, size_t Levels, typename Traits>
+bool lfq_priority<T, Levels, Traits>::enqueue(size_t level, T&& value) {
+	return emplace(level, std::move(value));
+}
+
+template <typename T, size_t Levels, typename Traits>
+template <typename... Args>
+bool lfq_priority<T, Levels, Traits>::emplace(size_t level, Args&&... args) {
+	assert(level < Levels);
+	if (!lanes_[level]->emplace(std::forward<Args>(args)...))
+		return false;
+	mark(level);
+	return true;
+}
+
+template <typename T, size_t Levels, typename Traits>
+void lfq_priority<T, Levels, Traits>::mark(size_t level) {
+	uint64_t const bit = uint64_t(1) << level;
+
+	// 与消费者"清位后复查"配对：要么消费者复查时看到新元素，要么这里看到位已被清掉
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+	// 已置位时只读不写，连续入队同一通道不会反复争用位图所在的缓存行
+	if ((nonempty_.load(std::memory_order_relaxed) & bit) == 0)
+		nonempty_.fetch_or(bit, std::memory_order_release);
+}
+
+template <typename T, size_t Levels, typename Traits>
+bool lfq_priority<T, Levels, Traits>::take(size_t level, T& value) {
+	if (lanes_[level]->dequeue(value))
+		return true;
+
+	// 1. 通道看起来为空：清位（栅栏与 mark() 中的栅栏配对）
+	uint64_t const bit = uint64_t(1) << level;
+	nonempty_.fetch_and(~bit, std::memory_order_seq_cst);
+	std::atomic_thread_fence(std::memory_order_seq_cst);
+
+	// 2. 复查：清位之前刚发布的元素在这里取到，并恢复该位
+	if (lanes_[level]->dequeue(value)) {
+		nonempty_.fetch_or(bit, std::memory_order_relaxed);
+		return true;
+	}
+	return false;
+}
+
+template <typename T, size_t Levels, typename Traits>
+bool lfq_priority<T, Levels, Traits>::dequeue(T& value) {
+	uint64_t mask = nonempty_.load(std::memory_order_acquire);
+
+	// 严格优先级：从最低位（最高优先级）开始，只访问置位的通道
+	if (!weighted_) {
+		while (mask != 0) {
+			size_t const level = lfq_ctz64(mask);
+			if (take(level, value))
+				return true;
+			mask &= mask - 1;
+		}
+		return false;
+	}
+
+	// 加权轮询：从当前通道开始找下一个置位的通道，每个通道最多访问一次
+	while (mask != 0) {
+		uint64_t const ahead = mask & (~uint64_t(0) << current_);
+		size_t const level = lfq_ctz64(ahead != 0 ? ahead : mask);
+		if (level != current_) {
+			current_ = level;
+			credit_ = weights_[level];
+		}
+
+		if (take(level, value)) {
+			// 本轮配额用完后换到下一个通道
+			if (--credit_ == 0) {
+				current_ = level + 1 == Levels ? 0 : level + 1;
+				credit_ = weights_[current_];
+			}
+			return true;
+		}
+		mask &= ~(uint64_t(1) << level);
+	}
+	return false;
+}
+
+template <typename T, size_t Levels, typename Traits>
+bool lfq_priority<T, Levels, Traits>::empty() const {
+	// 松散判空，只作参考
+	uint64_t mask = nonempty_.load(std::memory_order_acquire);
+	while (mask != 0) {
+		if (!lanes_[lfq_ctz64(mask)]->empty())
+			return false;
+		mask &= mask - 1;
+	}
+	return true;
+}
@@ -0,0 +1,178 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <utility>
+
+#include "lfq_common.h"
+#include "lfq_storage.h"
+
+// Dmitry Vyukov 的有界 MPMC 槽位协议，lfq_array_seq 与 lfq_shm 共用
+// 每个槽位带一个序号 seq，代替 ready 标志：
+//   seq == pos        槽位空闲，可由序号为 pos 的生产者写入
+//   seq == pos + 1    数据就绪，可由序号为 pos 的消费者读取
+//   读取后 seq 置为 pos + 容量，供下一圈的生产者使用
+// 生产者与消费者都只用一次 CAS 认领槽位
+// 槽位已被对端认领而尚未发布/归还时（seq 落后于 pos）有两种处理：
+//   emplace/dequeue          确认队列并非真的满/空后等待对端完成，不误报满/空（lfq_array_seq）
+//   try_emplace/try_dequeue  Vyukov 的原始做法，立即返回 false，从不等待对端（lfq_shm：对端可能是已退出的进程）
+template <typename T>
+struct lfq_seq_slot {
+	std::atomic<uint64_t> seq;	// 槽位序号
+	lfq_storage<T> data;		// 未初始化存储
+};
+
+// 只描述协议，不持有内存：槽位数组与 head/tail 计数器由使用方分配
+// lfq_array_seq 放在自己的成员里，lfq_shm 放在共享映射中（由映射起点加偏移量得到）
+template <typename T>
+class lfq_seq_ring {
+public:
+	using slot_type = lfq_seq_slot<T>;
+
+	lfq_seq_ring(slot_type* slots, size_t mask, std::atomic<uint64_t>& head, std::atomic<uint64_t>& tail)
+		: slots_(slots), mask_(mask), head_(&head), tail_(&tail) {}
+
+	// 把映射起点加偏移量处的字节解释为槽位数组（跨进程映射只保存偏移量）
+	static slot_type* slots_at(void* base, size_t offset) {
+		return reinterpret_cast<slot_type*>(static_cast<unsigned char*>(base) + offset);
+	}
+
+	// 初始化序号与计数器：第 i 个槽位首先由序号为 i 的生产者写入
+	void reset() noexcept;
+
+	template <typename... Args>
+	bool emplace(Args&&... args) { return emplace_impl<true>(std::forward<Args>(args)...); }
+
+	bool dequeue(T& value) { return dequeue_impl<true>(value); }
+
+	template <typename... Args>
+	bool try_emplace(Args&&... args) { return emplace_impl<false>(std::forward<Args>(args)...); }
+
+	bool try_dequeue(T& value) { return dequeue_impl<false>(value); }
+
+	// 析构剩余的元素（仅在没有并发操作时调用）
+	void destroy_remaining() noexcept;
+
+	// 松散判空，只作参考
+	bool empty() const {
+		return head_->load(std::memory_order_relaxed) == tail_->load(std::memory_order_relaxed);
+	}
+
+	size_t capacity() const { return mask_ + 1; }
+
+private:
+	// WaitPeer 为 false 时槽位仍被对端占用即返回 false
+	template <bool WaitPeer, typename... Args>
+	bool emplace_impl(Args&&... args);
+
+	template <bool WaitPeer>
+	bool dequeue_impl(T& value);
+
+	slot_type* slots_;					// 槽位数组
+	size_t mask_;						// 容量掩码
+	std::atomic<uint64_t>* head_;		// 消费者序号
+	std::atomic<uint64_t>* tail_;		// 生产者序号
+};
+
+template <typename T>
+void lfq_seq_ring<T>::reset() noexcept {
+	for (size_t i = 0; i <= mask_; ++i) {
+		slots_[i].seq.store(i, std::memory_order_relaxed);
+	}
+	head_->store(0, std::memory_order_relaxed);
+	tail_->store(0, std::memory_order_relaxed);
+}
+
+template <typename T>
+template <bool WaitPeer, typename... Args>
+bool lfq_seq_ring<T>::emplace_impl(Args&&... args) {
+	uint64_t pos = tail_->load(std::memory_order_relaxed);
+	slot_type* slot;
+	unsigned spins = 0;
+
+	// 1. 认领槽位
+	for (;;) {
+		slot = &slots_[pos & mask_];
+		uint64_t const seq = slot->seq.load(std::memory_order_acquire);
+		int64_t const diff = static_cast<int64_t>(seq - pos);
+
+		if (diff == 0) {
+			// 槽位空闲：CAS 成功即独占该槽位
+			if (tail_->compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0) {
+			// 上一圈的数据尚未被取走
+			if constexpr (!WaitPeer)
+				return false;
+			// 只有队列确实已满才返回 false；消费者已认领但未归还槽位时等待其完成
+			uint64_t const head = head_->load(std::memory_order_acquire);
+			if (static_cast<int64_t>(pos - head) > static_cast<int64_t>(mask_))
+				return false;
+			lfq_spin_wait(spins);
+			pos = tail_->load(std::memory_order_relaxed);
+		}
+		else {
+			// 其他生产者已抢先认领，重新读取 tail
+			pos = tail_->load(std::memory_order_relaxed);
+		}
+	}
+
+	// 2. 原地构造元素
+	slot->data.construct(std::forward<Args>(args)...);
+
+	// 3. 发布：seq = pos + 1 表示数据就绪
+	slot->seq.store(pos + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+template <bool WaitPeer>
+bool lfq_seq_ring<T>::dequeue_impl(T& value) {
+	uint64_t pos = head_->load(std::memory_order_relaxed);
+	slot_type* slot;
+	unsigned spins = 0;
+
+	// 1. 认领槽位
+	for (;;) {
+		slot = &slots_[pos & mask_];
+		uint64_t const seq = slot->seq.load(std::memory_order_acquire);
+		int64_t const diff = static_cast<int64_t>(seq - (pos + 1));
+
+		if (diff == 0) {
+			if (head_->compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+				break;
+		}
+		else if (diff < 0) {
+			// 数据尚未就绪
+			if constexpr (!WaitPeer)
+				return false;
+			// 只有队列确实为空才返回 false；生产者已认领但未发布时等待其完成
+			if (tail_->load(std::memory_order_acquire) == pos)
+				return false;
+			lfq_spin_wait(spins);
+			pos = head_->load(std::memory_order_relaxed);
+		}
+		else {
+			pos = head_->load(std::memory_order_relaxed);
+		}
+	}
+
+	// 2. 读取数据并析构槽位中的元素
+	slot->data.move_to(value);
+
+	// 3. 归还槽位给下一圈的生产者
+	slot->seq.store(pos + mask_ + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T>
+void lfq_seq_ring<T>::destroy_remaining() noexcept {
+	// seq == pos + 1 的槽位中有尚未取走的元素
+	uint64_t const tail = tail_->load(std::memory_order_acquire);
+	for (uint64_t pos = head_->load(std::memory_order_relaxed); pos != tail; ++pos) {
+		slot_type& slot = slots_[pos & mask_];
+		if (slot.seq.load(std::memory_order_acquire) == pos + 1)
+			slot.data.destroy();
+	}
+}
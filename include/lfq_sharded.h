@@ -0,0 +1,268 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+#include <vector>
+
+#include <stdexcept>
+
+#include "lfq_spsc.h"
+
+// 分片 MPSC 队列：每个生产者独占一个 lfq_spsc 环，生产者之间不共享任何写入的缓存行
+// 生产者用 producer_token（RAII）认领分片，或直接调用 enqueue(value) 由 thread_local 自动认领
+// 单消费者轮询各分片：每个分片连续取至多 drain_batch 个元素再换下一个（1 即逐个轮转）
+// 同一个 token（隐式认领时即同一线程）入队的元素保持 FIFO，不同生产者之间没有全局顺序
+// 分片数上限在构造时给定，环在首次被认领时才分配；认领已满时抛出 std::runtime_error
+template <typename T, typename Traits = lfq_default_traits>
+class lfq_sharded {
+public:
+	using ring_type = lfq_spsc<T, Traits>;
+
+	class producer_token {
+	public:
+		explicit producer_token(lfq_sharded& queue)
+			: queue_(queue), shard_(queue.claim_shard()), ring_(queue.ring_of(shard_)) {}
+
+		producer_token(const producer_token&) = delete;
+		producer_token& operator=(const producer_token&) = delete;
+
+		// 归还分片，其中未取走的元素仍由消费者取出
+		~producer_token() { queue_.owned_[shard_].store(false, std::memory_order_release); }
+
+	private:
+		friend class lfq_sharded;
+		lfq_sharded& queue_;
+		const size_t shard_;
+		ring_type* const ring_;
+	};
+
+	explicit lfq_sharded(size_t shard_capacity, size_t max_producers = 64, size_t drain_batch = 1);
+
+	lfq_sharded(const lfq_sharded&) = delete;
+	lfq_sharded& operator=(const lfq_sharded&) = delete;
+
+	// 显式 token：热路径只有 SPSC 环的一次入队
+	bool enqueue(producer_token& token, const T& value);
+
+	bool enqueue(producer_token& token, T&& value);
+
+	template <typename... Args>
+	bool emplace(producer_token& token, Args&&... args);
+
+	// 隐式 token：首次调用时为当前线程认领分片，线程退出时归还
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	bool dequeue(T& value);
+
+	// 按轮询顺序最多取出 max 个元素写入 out，返回实际取出的个数
+	template <typename OutIt>
+	size_t dequeue_bulk(OutIt out, size_t max);
+
+	bool empty() const;
+
+	// 单个分片的容量
+	size_t capacity() const { return shard_capacity_; }
+
+	// 析构全部分片中剩余的元素
+	~lfq_sharded();
+
+private:
+	struct alignas(64) shard {
+		std::atomic<ring_type*> ring{ nullptr };	// 首次认领时创建，之后不再改变
+	};
+
+	// 线程退出时归还隐式认领的分片；占用标志由 shared_ptr 持有，队列先析构也不会悬空
+	struct implicit_entry {
+		uint64_t queue;
+		size_t shard;
+		ring_type* ring;
+		std::shared_ptr<std::atomic<bool>[]> owned;
+	};
+	struct implicit_tokens {
+		std::vector<implicit_entry> entries;
+		~implicit_tokens() {
+			for (auto& e : entries)
+				e.owned[e.shard].store(false, std::memory_order_release);
+		}
+	};
+
+	size_t claim_shard();
+
+	ring_type* ring_of(size_t shard) const { return shards_[shard].ring.load(std::memory_order_acquire); }
+
+	ring_type* implicit_ring();
+
+	static std::atomic<uint64_t>& next_id() {
+		static std::atomic<uint64_t> id{ 1 };
+		return id;
+	}
+
+	const size_t shard_capacity_;	// 每个分片的容量
+	const size_t max_producers_;	// 分片个数
+	const size_t drain_batch_;		// 消费者在一个分片上连续取出的个数
+	const uint64_t id_;				// 队列编号，不会复用
+	std::unique_ptr<shard[]> shards_;
+	std::shared_ptr<std::atomic<bool>[]> owned_;	// 分片占用标志
+	alignas(64) std::atomic<size_t> high_water_{ 0 };	// 曾被认领过的最大分片下标 + 1
+	alignas(64) size_t next_ = 0;	// 消费者当前轮询到的分片（仅消费者访问）
+	size_t burst_ = 0;				// 在当前分片上已连续取出的个数
+};
+
+template <typename T, typename Traits>
+lfq_sharded<T, Traits>::lfq_sharded(size_t shard_capacity, size_t max_producers, size_t drain_batch)
+	: shard_capacity_(shard_capacity),
+	max_producers_(max_producers),
+	drain_batch_(drain_batch == 0 ? 1 : drain_batch),
+	id_(next_id().fetch_add(1, std::memory_order_relaxed)),
+	shards_(new shard[max_producers]),
+	owned_(new std::atomic<bool>[max_producers]()) {
+	if (shard_capacity == 0 || max_producers == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+}
+
+template <typename T, typename Traits>
+lfq_sharded<T, Traits>::~lfq_sharded() {
+	for (size_t i = 0; i < max_producers_; ++i)
+		delete shards_[i].ring.load(std::memory_order_acquire);
+}
+
+template <typename T, typename Traits>
+size_t lfq_sharded<T, Traits>::claim_shard() {
+	for (size_t i = 0; i < max_producers_; ++i) {
+		bool expected = false;
+		if (owned_[i].load(std::memory_order_relaxed) ||
+			!owned_[i].compare_exchange_strong(expected, true, std::memory_order_acquire))
+			continue;
+
+		// 认领者独占该分片，首次使用时创建环
+		if (shards_[i].ring.load(std::memory_order_acquire) == nullptr)
+			shards_[i].ring.store(new ring_type(shard_capacity_), std::memory_order_release);
+
+		// 让消费者的轮询范围覆盖该分片
+		size_t hw = high_water_.load(std::memory_order_relaxed);
+		while (hw < i + 1 && !high_water_.compare_exchange_weak(hw, i + 1, std::memory_order_release, std::memory_order_relaxed)) {}
+		return i;
+	}
+	throw std::runtime_error("No free producer shard.");
+}
+
+template <typename T, typename Traits>
+typename lfq_sharded<T, Traits>::ring_type* lfq_sharded<T, Traits>::implicit_ring() {
+	thread_local implicit_tokens tokens;
+
+	for (auto& e : tokens.entries) {
+		if (e.queue == id_)
+			return e.ring;
+	}
+
+	// 顺便清理已析构队列的条目（只剩本线程持有占用标志）
+	auto& entries = tokens.entries;
+	for (size_t i = 0; i < entries.size();) {
+		if (entries[i].owned.use_count() == 1) {
+			entries[i] = std::move(entries.back());
+			entries.pop_back();
+		}
+		else {
+			++i;
+		}
+	}
+
+	size_t const s = claim_shard();
+	entries.push_back(implicit_entry{ id_, s, ring_of(s), owned_ });
+	return entries.back().ring;
+}
+
+template <typename T, typename Traits>
+bool lfq_sharded<T, Traits>::enqueue(producer_token& token, const T& value) {
+	return token.ring_->emplace(value);
+}
+
+template <typename T, typename Traits>
+bool lfq_sharded<T, Traits>::enqueue(producer_token& token, T&& value) {
+	return token.ring_->emplace(std::move(value));
+}
+
+template <typename T, typename Traits>
+template <typename... Args>
+bool lfq_sharded<T, Traits>::emplace(producer_token& token, Args&&... args) {
+	return token.ring_->emplace(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Traits>
+bool lfq_sharded<T, Traits>::enqueue(const T& value) {
+	return implicit_ring()->emplace(value);
+}
+
+template <typename T, typename Traits>
+bool lfq_sharded<T, Traits>::enqueue(T&& value) {
+	return implicit_ring()->emplace(std::move(value));
+}
+
+template <typename T, typename Traits>
+bool lfq_sharded<T, Traits>::dequeue(T& value) {
+	size_t const n = high_water_.load(std::memory_order_acquire);
+
+	// 最多检查一轮：从当前分片开始，取到元素即返回
+	for (size_t tried = 0; tried < n; ++tried) {
+		if (next_ >= n)
+			next_ = 0;
+		ring_type* ring = ring_of(next_);
+		if (ring && ring->dequeue(value)) {
+			// 在同一分片上连续取满 drain_batch 个后换下一个
+			if (++burst_ >= drain_batch_) {
+				burst_ = 0;
+				++next_;
+			}
+			return true;
+		}
+		burst_ = 0;
+		++next_;
+	}
+	return false;
+}
+
+template <typename T, typename Traits>
+template <typename OutIt>
+size_t lfq_sharded<T, Traits>::dequeue_bulk(OutIt out, size_t max) {
+	size_t const n = high_water_.load(std::memory_order_acquire);
+	size_t count = 0;
+	size_t idle = 0;	// 连续取空的分片数，满一轮即停止
+
+	while (count < max && idle < n) {
+		if (next_ >= n)
+			next_ = 0;
+		ring_type* ring = ring_of(next_);
+		size_t got = 0;
+		if (ring) {
+			// 原地移出，不要求 OutIt 解引用为 T&
+			T* p;
+			while (got < drain_batch_ && count < max && (p = ring->peek()) != nullptr) {
+				*out = std::move(*p);
+				++out;
+				ring->release();
+				++got;
+				++count;
+			}
+		}
+		idle = got == 0 ? idle + 1 : 0;
+		burst_ = 0;
+		++next_;
+	}
+	return count;
+}
+
+template <typename T, typename Traits>
+bool lfq_sharded<T, Traits>::empty() const {
+	// 松散判空，只作参考
+	size_t const n = high_water_.load(std::memory_order_acquire);
+	for (size_t i = 0; i < n; ++i) {
+		ring_type* ring = ring_of(i);
+		if (ring && !ring->empty())
+			return false;
+	}
+	return true;
+}
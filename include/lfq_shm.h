@@ -0,0 +1,396 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+#include <new>
+#include <string>
+#include <utility>
+#include <type_traits>
+#include <chrono>
+
+#include <stdexcept>
+#include <system_error>
+
+#include "lfq_common.h"
+#include "lfq_traits.h"
+#include "lfq_wait.h"
+#include "lfq_seq_ring.h"
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#define LFQ_HAS_SHM 1
+#endif
+
+#if defined(LFQ_HAS_SHM)
+
+// 跨进程共享内存环形队列（MPMC，POSIX）
+// 头部（魔数、布局版本、容量、head/tail）与槽位都位于同一段 shm_open/memfd 映射中：
+//   [ 头部 | 填充到缓存行 | 槽位 0 | 槽位 1 | ... ]
+// 映射内只保存偏移量，不保存指针，各进程把同一段内存映射到不同地址也能正确访问
+// 槽位协议与 lfq_array_seq 共用 lfq_seq_ring（每个槽位带序号 seq），任意进程可同时作为生产者和消费者
+// 只支持可平凡复制的 T：元素按字节写入映射，不能持有指向本进程内存的指针或资源
+// enqueue/dequeue 从不等待其他进程：队首槽位已被生产者认领而尚未发布时 dequeue 返回 false（Vyukov 的原始协议）
+// 生产者在认领后、发布前被挂起或退出不会让其他进程卡在 dequeue 中；只有 dequeue_wait 会等待，且受超时限制
+// 进程在认领槽位后、发布前退出会使该槽位永久占用，此后 dequeue 一直返回 false
+//
+// 用法：
+//   auto q = lfq_shm<msg>::create("/orders", 4096);   // 创建方，名字已存在时失败
+//   auto q = lfq_shm<msg>::attach("/orders");         // 其他进程，校验布局后使用
+//   lfq_shm<msg>::unlink("/orders");                  // 不再需要时删除名字，已有映射仍有效
+template <typename T>
+class lfq_shm {
+	static_assert(std::is_trivially_copyable<T>::value, "lfq_shm requires a trivially copyable T.");
+	static_assert(std::atomic<uint64_t>::is_always_lock_free, "Cross-process atomics must be lock-free.");
+
+public:
+	static constexpr uint64_t magic_value = 0x31304D4853514C46ull;	// "LFQSHM01"
+	static constexpr uint32_t layout_version = 1;
+
+	// 创建具名队列（shm_open），容量向上取整为2的幂
+	static lfq_shm create(const std::string& name, size_t capacity);
+
+	// 连接已存在的具名队列；创建方尚未完成初始化时等待至多 timeout
+	static lfq_shm attach(const std::string& name,
+		std::chrono::milliseconds timeout = std::chrono::milliseconds(1000));
+
+#if defined(__linux__)
+	// 创建匿名队列（memfd），通过 fork 继承，或把 fd() 传给其他进程后 attach_fd
+	static lfq_shm create_anonymous(size_t capacity);
+#endif
+
+	// 连接一个已初始化的队列描述符（内部复制 fd，调用方仍负责关闭自己的描述符）
+	static lfq_shm attach_fd(int fd);
+
+	// 删除具名队列的名字
+	static void unlink(const std::string& name);
+
+	lfq_shm(lfq_shm&& other) noexcept;
+
+	lfq_shm& operator=(lfq_shm&& other) noexcept;
+
+	lfq_shm(const lfq_shm&) = delete;
+
+	lfq_shm& operator=(const lfq_shm&) = delete;
+
+	// 解除映射并关闭描述符，不删除名字
+	~lfq_shm();
+
+	bool enqueue(const T& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	bool dequeue(T& value);
+
+	// 等待直到取得元素或超时：队列为空、队首元素尚未发布时都继续等待
+	template <typename Rep, typename Period>
+	bool dequeue_wait(T& value, const std::chrono::duration<Rep, Period>& timeout);
+
+	// 无超时，一直等待
+	bool dequeue_wait(T& value);
+
+	bool empty() const;
+
+	size_t capacity() const { return ring_.capacity(); }
+
+	int fd() const { return fd_; }
+
+private:
+	// 映射开头的头部，布局由 layout_version 标识；修改字段时必须增加版本号
+	struct Header {
+		std::atomic<uint64_t> magic;	// 创建方初始化完成后最后写入（release）
+		uint32_t version;				// 布局版本
+		uint32_t slot_size;				// sizeof(Slot)
+		uint64_t value_size;			// sizeof(T)
+		uint64_t capacity;				// 槽位数（2的幂）
+		uint64_t slots_offset;			// 槽位数组相对映射起点的偏移
+		uint64_t mapping_size;			// 映射总长度
+		alignas(64) std::atomic<uint64_t> head;	// 消费者序号
+		alignas(64) std::atomic<uint64_t> tail;	// 生产者序号
+	};
+
+	using Slot = typename lfq_seq_ring<T>::slot_type;
+
+	// 映射失败路径上的守卫：未 release 时析构即解除映射
+	struct mapping_guard {
+		void* base;
+		size_t length;
+
+		mapping_guard(void* b, size_t len) : base(b), length(len) {}
+		mapping_guard(const mapping_guard&) = delete;
+		mapping_guard& operator=(const mapping_guard&) = delete;
+		~mapping_guard() {
+			if (base)
+				munmap(base, length);
+		}
+
+		void* release() noexcept { return std::exchange(base, nullptr); }
+	};
+
+	static constexpr size_t slots_align_ = alignof(Slot) > lfq_cache_line ? alignof(Slot) : lfq_cache_line;
+	static constexpr size_t slots_offset_ = (sizeof(Header) + slots_align_ - 1) / slots_align_ * slots_align_;
+
+	lfq_shm(int fd, void* base, size_t length);
+
+	// 由映射起点与头部记录的偏移量得到槽位协议
+	static lfq_seq_ring<T> ring_at(void* base);
+
+	static lfq_shm create_on(int fd, size_t capacity);
+
+	static lfq_shm map_existing(int fd, std::chrono::milliseconds timeout);
+
+	[[noreturn]] static void throw_errno(const char* what);
+
+	void unmap() noexcept;
+
+	void* base_;			// 本进程中的映射起点
+	size_t length_;			// 映射长度
+	int fd_;				// 映射对应的描述符
+	lfq_seq_ring<T> ring_;	// 指向映射中的槽位与 head/tail，仅在本进程有效
+};
+
+template <typename T>
+void lfq_shm<T>::throw_errno(const char* what) {
+	throw std::system_error(errno, std::generic_category(), what);
+}
+
+template <typename T>
+lfq_seq_ring<T> lfq_shm<T>::ring_at(void* base) {
+	Header* const header = static_cast<Header*>(base);
+	return lfq_seq_ring<T>(lfq_seq_ring<T>::slots_at(base, header->slots_offset),
+		static_cast<size_t>(header->capacity) - 1, header->head, header->tail);
+}
+
+template <typename T>
+lfq_shm<T>::lfq_shm(int fd, void* base, size_t length)
+	: base_(base),
+	length_(length),
+	fd_(fd),
+	ring_(ring_at(base)) {
+}
+
+template <typename T>
+lfq_shm<T>::lfq_shm(lfq_shm&& other) noexcept
+	: base_(std::exchange(other.base_, nullptr)),
+	length_(std::exchange(other.length_, 0)),
+	fd_(std::exchange(other.fd_, -1)),
+	ring_(other.ring_) {
+}
+
+template <typename T>
+lfq_shm<T>& lfq_shm<T>::operator=(lfq_shm&& other) noexcept {
+	if (this != &other) {
+		unmap();
+		base_ = std::exchange(other.base_, nullptr);
+		length_ = std::exchange(other.length_, 0);
+		fd_ = std::exchange(other.fd_, -1);
+		ring_ = other.ring_;
+	}
+	return *this;
+}
+
+template <typename T>
+lfq_shm<T>::~lfq_shm() {
+	unmap();
+}
+
+template <typename T>
+void lfq_shm<T>::unmap() noexcept {
+	if (base_)
+		munmap(base_, length_);
+	if (fd_ >= 0)
+		close(fd_);
+	base_ = nullptr;
+	fd_ = -1;
+}
+
+template <typename T>
+lfq_shm<T> lfq_shm<T>::create(const std::string& name, size_t capacity) {
+	if (capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+	int const fd = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+	if (fd < 0)
+		throw_errno("shm_open");
+	try {
+		return create_on(fd, capacity);
+	}
+	catch (...) {
+		close(fd);
+		shm_unlink(name.c_str());
+		throw;
+	}
+}
+
+#if defined(__linux__)
+template <typename T>
+lfq_shm<T> lfq_shm<T>::create_anonymous(size_t capacity) {
+	if (capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+	int const fd = memfd_create("lfq_shm", MFD_CLOEXEC);
+	if (fd < 0)
+		throw_errno("memfd_create");
+	try {
+		return create_on(fd, capacity);
+	}
+	catch (...) {
+		close(fd);
+		throw;
+	}
+}
+#endif
+
+template <typename T>
+lfq_shm<T> lfq_shm<T>::create_on(int fd, size_t capacity) {
+	size_t const slots = lfq_round_up_pow2(capacity);
+	size_t const length = slots_offset_ + slots * sizeof(Slot);
+
+	// 1. 设定长度（新增部分由内核清零）并映射
+	if (ftruncate(fd, static_cast<off_t>(length)) != 0)
+		throw_errno("ftruncate");
+	void* const base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (base == MAP_FAILED)
+		throw_errno("mmap");
+	mapping_guard mapping(base, length);
+
+	// 2. 初始化头部与槽位：第 i 个槽位首先由序号为 i 的生产者写入
+	Header* const header = ::new (base) Header;
+	header->version = layout_version;
+	header->slot_size = static_cast<uint32_t>(sizeof(Slot));
+	header->value_size = sizeof(T);
+	header->capacity = slots;
+	header->slots_offset = slots_offset_;
+	header->mapping_size = length;
+
+	Slot* const array = lfq_seq_ring<T>::slots_at(base, slots_offset_);
+	for (size_t i = 0; i < slots; ++i) {
+		::new (static_cast<void*>(&array[i])) Slot;
+	}
+	ring_at(base).reset();
+
+	// 3. 最后写入魔数，attach 方看到魔数即可见以上全部初始化
+	header->magic.store(magic_value, std::memory_order_release);
+	lfq_shm queue(fd, base, length);
+	mapping.release();
+	return queue;
+}
+
+template <typename T>
+lfq_shm<T> lfq_shm<T>::attach(const std::string& name, std::chrono::milliseconds timeout) {
+	int const fd = shm_open(name.c_str(), O_RDWR, 0);
+	if (fd < 0)
+		throw_errno("shm_open");
+	try {
+		return map_existing(fd, timeout);
+	}
+	catch (...) {
+		close(fd);
+		throw;
+	}
+}
+
+template <typename T>
+lfq_shm<T> lfq_shm<T>::attach_fd(int fd) {
+	int const own = dup(fd);
+	if (own < 0)
+		throw_errno("dup");
+	try {
+		return map_existing(own, std::chrono::milliseconds(0));
+	}
+	catch (...) {
+		close(own);
+		throw;
+	}
+}
+
+template <typename T>
+lfq_shm<T> lfq_shm<T>::map_existing(int fd, std::chrono::milliseconds timeout) {
+	auto const deadline = std::chrono::steady_clock::now() + timeout;
+	unsigned spins = 0;
+
+	// 1. 等待创建方设定长度（shm_open 与 ftruncate 之间长度为0）
+	struct stat st;
+	for (;;) {
+		if (fstat(fd, &st) != 0)
+			throw_errno("fstat");
+		if (static_cast<size_t>(st.st_size) >= sizeof(Header))
+			break;
+		if (std::chrono::steady_clock::now() >= deadline)
+			throw std::runtime_error("Shared-memory queue is not initialized.");
+		lfq_spin_wait(spins);
+	}
+
+	size_t const length = static_cast<size_t>(st.st_size);
+	void* const base = mmap(nullptr, length, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+	if (base == MAP_FAILED)
+		throw_errno("mmap");
+	mapping_guard mapping(base, length);
+	Header* const header = static_cast<Header*>(base);
+
+	// 2. 等待魔数，之后校验布局是否与本进程的 T 一致（失败时由 mapping 解除映射）
+	while (header->magic.load(std::memory_order_acquire) != magic_value) {
+		if (std::chrono::steady_clock::now() >= deadline)
+			throw std::runtime_error("Shared-memory queue is not initialized.");
+		lfq_spin_wait(spins);
+	}
+	uint64_t const slots = header->capacity;
+	if (header->version != layout_version
+		|| header->slot_size != sizeof(Slot)
+		|| header->value_size != sizeof(T)
+		|| header->slots_offset != slots_offset_
+		|| slots == 0 || (slots & (slots - 1)) != 0
+		|| header->mapping_size != slots_offset_ + slots * sizeof(Slot)
+		|| header->mapping_size > length) {
+		throw std::runtime_error("Shared-memory queue layout mismatch.");
+	}
+	lfq_shm queue(fd, base, length);
+	mapping.release();
+	return queue;
+}
+
+template <typename T>
+void lfq_shm<T>::unlink(const std::string& name) {
+	if (shm_unlink(name.c_str()) != 0)
+		throw_errno("shm_unlink");
+}
+
+template <typename T>
+bool lfq_shm<T>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T>
+template <typename... Args>
+bool lfq_shm<T>::emplace(Args&&... args) {
+	return ring_.try_emplace(std::forward<Args>(args)...);
+}
+
+template <typename T>
+bool lfq_shm<T>::dequeue(T& value) {
+	return ring_.try_dequeue(value);
+}
+
+template <typename T>
+template <typename Rep, typename Period>
+bool lfq_shm<T>::dequeue_wait(T& value, const std::chrono::duration<Rep, Period>& timeout) {
+	// 对端可能在其他进程中，没有可用的唤醒通知：自旋后让出时间片
+	return lfq_spin_yield_wait<>().wait_until([&] { return ring_.try_dequeue(value); }, lfq_deadline(timeout));
+}
+
+template <typename T>
+bool lfq_shm<T>::dequeue_wait(T& value) {
+	return lfq_spin_yield_wait<>().wait_until([&] { return ring_.try_dequeue(value); }, lfq_clock::time_point::max());
+}
+
+template <typename T>
+bool lfq_shm<T>::empty() const {
+	// 松散判空，只作参考
+	return ring_.empty();
+}
+
+#endif // LFQ_HAS_SHM
@@ -0,0 +1,191 @@
+#pragma once
+
+#include <atomic>
+#include <memory>
+#include <cstdint>
+
+#include <stdexcept>
+#include <cassert>
+
+#include "lfq_traits.h"
+#include "lfq_storage.h"
+
+// 单生产者单消费者环形队列（wait-free）
+// tail_ 只由生产者写、head_ 只由消费者写，入队/出队都是普通的 load/store，没有原子读改写
+// 各自缓存对方的序号，只在缓存显示满/空时才读取对方的缓存行
+// 接口与 lfq_array_based 相同，拓扑允许时可直接替换
+// 序号到槽位的映射沿用 Traits::index_policy（默认取模保留一个空槽，lfq_pow2_traits 全部可用）
+// 槽位为未初始化存储，入队时原地构造、出队时析构
+template <typename T, typename Traits = lfq_default_traits>
+class lfq_spsc {
+public:
+	using index_type = typename Traits::index_policy;
+
+	explicit lfq_spsc(size_t capacity);
+
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	bool dequeue(T& value);
+
+	// 两阶段接口（零拷贝），语义同 lfq_array_based
+	// 生产者同一时刻只能持有一个预留，commit 之前不能再次 try_reserve
+	template <typename... Args>
+	T* try_reserve(Args&&... args);
+
+	void commit(T* reserved);
+
+	T* peek();
+
+	void release();
+
+	bool empty() const;
+
+	size_t capacity() const { return capacity_; }
+
+	// 析构队列中剩余的元素
+	~lfq_spsc();
+
+private:
+	const index_type index_;		// 序号到槽位的映射
+	const size_t capacity_;			// 可用容量
+	std::unique_ptr<lfq_storage<T>[]> buffer_;	// 槽位数组（未初始化存储）
+
+	alignas(64) std::atomic<uint64_t> head_;	// 消费者序号
+	uint64_t tail_cache_;						// 消费者缓存的 tail（仅消费者访问）
+	alignas(64) std::atomic<uint64_t> tail_;	// 生产者序号
+	uint64_t head_cache_;						// 生产者缓存的 head（仅生产者访问）
+};
+
+template <typename T, typename Traits>
+lfq_spsc<T, Traits>::lfq_spsc(size_t capacity)
+	: index_(capacity),
+	capacity_(index_.usable()),
+	buffer_(new lfq_storage<T>[index_.slots()]),
+	head_(0),
+	tail_cache_(0),
+	tail_(0),
+	head_cache_(0) {
+	if (capacity == 0) {
+		throw std::invalid_argument("Capacity must be greater than zero.");
+	}
+}
+
+template <typename T, typename Traits>
+lfq_spsc<T, Traits>::~lfq_spsc() {
+	uint64_t const tail = tail_.load(std::memory_order_acquire);
+	for (uint64_t i = head_.load(std::memory_order_relaxed); i != tail; ++i) {
+		buffer_[index_(i)].destroy();
+	}
+}
+
+template <typename T, typename Traits>
+bool lfq_spsc<T, Traits>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T, typename Traits>
+bool lfq_spsc<T, Traits>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T, typename Traits>
+template <typename... Args>
+bool lfq_spsc<T, Traits>::emplace(Args&&... args) {
+	// tail_ 只有本线程写，relaxed 读取即可
+	uint64_t const tail = tail_.load(std::memory_order_relaxed);
+
+	// 1. 检查空间：缓存显示已满时才重新读取 head_
+	if (tail - head_cache_ >= capacity_) {
+		head_cache_ = head_.load(std::memory_order_acquire);
+		if (tail - head_cache_ >= capacity_) {
+			return false; // 队列已满
+		}
+	}
+
+	// 2. 原地构造元素
+	buffer_[index_(tail)].construct(std::forward<Args>(args)...);
+
+	// 3. 发布
+	tail_.store(tail + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T, typename Traits>
+bool lfq_spsc<T, Traits>::dequeue(T& value) {
+	uint64_t const head = head_.load(std::memory_order_relaxed);
+
+	// 1. 检查数据：缓存显示为空时才重新读取 tail_
+	if (head == tail_cache_) {
+		tail_cache_ = tail_.load(std::memory_order_acquire);
+		if (head == tail_cache_) {
+			return false; // 队列为空
+		}
+	}
+
+	// 2. 读取数据并析构槽位中的元素
+	buffer_[index_(head)].move_to(value);
+
+	// 3. 归还槽位
+	head_.store(head + 1, std::memory_order_release);
+	return true;
+}
+
+template <typename T, typename Traits>
+template <typename... Args>
+T* lfq_spsc<T, Traits>::try_reserve(Args&&... args) {
+	uint64_t const tail = tail_.load(std::memory_order_relaxed);
+
+	if (tail - head_cache_ >= capacity_) {
+		head_cache_ = head_.load(std::memory_order_acquire);
+		if (tail - head_cache_ >= capacity_) {
+			return nullptr; // 队列已满
+		}
+	}
+
+	// tail_ 尚未前移，消费者看不到该槽位
+	if constexpr (sizeof...(Args) == 0)
+		return buffer_[index_(tail)].construct_default();
+	else
+		return buffer_[index_(tail)].construct(std::forward<Args>(args)...);
+}
+
+template <typename T, typename Traits>
+void lfq_spsc<T, Traits>::commit(T* reserved) {
+	uint64_t const tail = tail_.load(std::memory_order_relaxed);
+	assert(buffer_[index_(tail)].get() == reserved);
+	(void)reserved;
+	tail_.store(tail + 1, std::memory_order_release);
+}
+
+template <typename T, typename Traits>
+T* lfq_spsc<T, Traits>::peek() {
+	uint64_t const head = head_.load(std::memory_order_relaxed);
+
+	if (head == tail_cache_) {
+		tail_cache_ = tail_.load(std::memory_order_acquire);
+		if (head == tail_cache_) {
+			return nullptr; // 队列为空
+		}
+	}
+	return buffer_[index_(head)].get();
+}
+
+template <typename T, typename Traits>
+void lfq_spsc<T, Traits>::release() {
+	uint64_t const head = head_.load(std::memory_order_relaxed);
+	assert(head != tail_cache_);
+	buffer_[index_(head)].destroy();
+	head_.store(head + 1, std::memory_order_release);
+}
+
+template <typename T, typename Traits>
+bool lfq_spsc<T, Traits>::empty() const {
+	// 松散判空，只作参考；先以 acquire 读取 head，随后读到的 tail 不会比 head 旧（同 lfq_array_based::empty）
+	uint64_t const head = head_.load(std::memory_order_acquire);
+	return head == tail_.load(std::memory_order_relaxed);
+}
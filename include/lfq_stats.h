@@ -0,0 +1,132 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <thread>
+
+#include "lfq_common.h"
+
+// 热路径统计：Traits::stats_policy 选择
+//   lfq_no_stats      默认，全部为空函数，编译后不留任何代码
+//   lfq_thread_stats  每个线程一块计数器，只由本线程写（普通的 load/store，无原子读改写），snapshot() 汇总
+// 定义 LFQ_ENABLE_STATS 时 lfq_default_traits 改用 lfq_thread_stats，不必修改代码即可打开统计
+
+// 计数项
+enum class lfq_stat : unsigned {
+	enqueued,		// 入队成功的元素个数
+	dequeued,		// 出队成功的元素个数
+	cas_retry,		// head/tail 的 CAS 失败重试次数
+	backoff_yield,	// 退避达到上限后让出时间片的次数（见 lfq_backoff.h）
+	full,			// 因队列已满而拒绝的入队
+	slot_busy,		// 有空间但目标槽位尚未被消费者清空而拒绝的入队
+	empty,			// 因队列为空而失败的出队
+	not_ready,		// 元素已被认领但生产者尚未写完而失败的出队（ready 标志未置位）
+	count_
+};
+
+// 汇总结果
+struct lfq_stats_snapshot {
+	uint64_t counters[static_cast<size_t>(lfq_stat::count_)] = {};
+	uint64_t high_water = 0;	// 入队时观察到的最大元素个数
+	size_t threads = 0;			// 参与过统计的线程数
+
+	uint64_t operator[](lfq_stat s) const { return counters[static_cast<size_t>(s)]; }
+};
+
+struct lfq_no_stats {
+	static constexpr bool enabled = false;
+
+	void add(lfq_stat, uint64_t = 1) noexcept {}
+
+	void observe_depth(uint64_t) noexcept {}
+
+	lfq_stats_snapshot snapshot() const { return {}; }
+};
+
+// 每个线程首次在某个队列上计数时登记一块计数器，之后按队列的稠密下标在 thread_local 表中直接定位（lfq_local_cache）
+// 计数块归队列所有，随队列析构释放；线程局部表长度固定，不随用过的队列个数增长
+// 线程退出后其计数保留在快照中（线程编号被新线程复用时两者共用一块计数器）
+class lfq_thread_stats {
+public:
+	static constexpr bool enabled = true;
+
+	lfq_thread_stats() = default;
+
+	lfq_thread_stats(const lfq_thread_stats&) = delete;
+	lfq_thread_stats& operator=(const lfq_thread_stats&) = delete;
+
+	~lfq_thread_stats() {
+		block* b = blocks_.load(std::memory_order_acquire);
+		while (b) {
+			block* next = b->next;
+			delete b;
+			b = next;
+		}
+	}
+
+	void add(lfq_stat s, uint64_t n = 1) noexcept {
+		auto& c = local().counters[static_cast<size_t>(s)];
+		c.store(c.load(std::memory_order_relaxed) + n, std::memory_order_relaxed);
+	}
+
+	void observe_depth(uint64_t depth) noexcept {
+		auto& hw = local().high_water;
+		if (depth > hw.load(std::memory_order_relaxed))
+			hw.store(depth, std::memory_order_relaxed);
+	}
+
+	// 汇总所有线程的计数（与计数并发时得到的是近似值）
+	lfq_stats_snapshot snapshot() const {
+		lfq_stats_snapshot r;
+		for (block* b = blocks_.load(std::memory_order_acquire); b; b = b->next) {
+			for (size_t i = 0; i < static_cast<size_t>(lfq_stat::count_); ++i)
+				r.counters[i] += b->counters[i].load(std::memory_order_relaxed);
+			uint64_t const hw = b->high_water.load(std::memory_order_relaxed);
+			if (hw > r.high_water)
+				r.high_water = hw;
+			++r.threads;
+		}
+		return r;
+	}
+
+private:
+	struct alignas(lfq_cache_line) block {
+		std::atomic<uint64_t> counters[static_cast<size_t>(lfq_stat::count_)] = {};
+		std::atomic<uint64_t> high_water{ 0 };
+		std::thread::id owner;	// 登记该块的线程，发布后不再改变
+		block* next = nullptr;
+	};
+
+	block& local() {
+		// 命中线程局部表：一次下标访问，没有查找
+		if (block** cached = cache_.find())
+			return **cached;
+		return register_thread();
+	}
+
+	// 首次访问，或同时存活的统计对象过多而没有缓存下标：在本对象的计数块中找本线程的，没有则新建
+	block& register_thread() {
+		std::thread::id const self = std::this_thread::get_id();
+		block* b = nullptr;
+		for (block* p = blocks_.load(std::memory_order_acquire); p; p = p->next) {
+			if (p->owner == self) {
+				b = p;
+				break;
+			}
+		}
+		if (!b) {
+			b = new block;
+			b->owner = self;
+			block* top = blocks_.load(std::memory_order_relaxed);
+			do {
+				b->next = top;
+			} while (!blocks_.compare_exchange_weak(top, b, std::memory_order_release, std::memory_order_relaxed));
+		}
+		cache_.store(b);
+		return *b;
+	}
+
+	lfq_local_cache<lfq_thread_stats, block*> cache_;	// 本线程的计数块
+	std::atomic<block*> blocks_{ nullptr };
+};
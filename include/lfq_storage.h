@@ -0,0 +1,40 @@
+#pragma once
+
+#include <new>
+#include <utility>
+
+// 未初始化的元素存储：入队时原地构造，出队时析构
+// 不要求 T 可默认构造，构造队列也不会为每个槽位调用 T 的构造函数
+template <typename T>
+struct lfq_storage {
+	alignas(T) unsigned char bytes[sizeof(T)];
+
+	template <typename... Args>
+	T* construct(Args&&... args) {
+		return ::new (static_cast<void*>(bytes)) T(std::forward<Args>(args)...);
+	}
+
+	// 默认初始化：平凡类型不清零，供调用方随后就地填写
+	T* construct_default() {
+		return ::new (static_cast<void*>(bytes)) T;
+	}
+
+	void destroy() noexcept {
+		get()->~T();
+	}
+
+	T* get() noexcept {
+		return std::launder(reinterpret_cast<T*>(bytes));
+	}
+
+	const T* get() const noexcept {
+		return std::launder(reinterpret_cast<const T*>(bytes));
+	}
+
+	// 移出元素并立即析构，释放其持有的资源
+	void move_to(T& out) {
+		T* p = get();
+		out = std::move(*p);
+		p->~T();
+	}
+};
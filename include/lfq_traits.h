@@ -0,0 +1,116 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <stdexcept>
+
+#include "lfq_layout.h"
+#include "lfq_wait.h"
+#include "lfq_backoff.h"
+#include "lfq_stats.h"
+#include "lfq_latency.h"
+#include "lfq_alloc.h"
+
+// 队列的可配置策略
+// 使用方式：继承 lfq_default_traits 并覆盖需要修改的类型，例如
+//   struct my_traits : lfq_default_traits { using index_policy = lfq_pow2_index; };
+//   lfq_array_based<int, my_traits> queue(1000);
+
+// 向上取整到2的幂
+inline size_t lfq_round_up_pow2(size_t n) {
+	if (n > (std::numeric_limits<size_t>::max() >> 1) + 1) {
+		throw std::invalid_argument("Capacity is too large.");
+	}
+	size_t p = 1;
+	while (p < n)
+		p <<= 1;
+	return p;
+}
+
+// 取模索引：槽位数等于给定容量，保留一个空槽区分满/空（容量5实际可用4）
+struct lfq_modulo_index {
+	explicit lfq_modulo_index(size_t capacity)
+		: slots_(capacity) {}
+
+	// 实际分配的槽位数
+	size_t slots() const { return slots_; }
+
+	// 可同时容纳的元素个数
+	size_t usable() const { return slots_ - 1; }
+
+	// 单调序号 -> 槽位下标
+	size_t operator()(uint64_t seq) const { return static_cast<size_t>(seq % slots_); }
+
+private:
+	size_t slots_;
+};
+
+// 2的幂索引：容量向上取整到2的幂，用掩码代替取模，全部槽位可用
+struct lfq_pow2_index {
+	explicit lfq_pow2_index(size_t capacity)
+		: mask_(lfq_round_up_pow2(capacity) - 1) {}
+
+	size_t slots() const { return mask_ + 1; }
+
+	size_t usable() const { return mask_ + 1; }
+
+	size_t operator()(uint64_t seq) const { return static_cast<size_t>(seq) & mask_; }
+
+private:
+	size_t mask_;
+};
+
+// 单消费者：出队直接写 head（默认，MPSC）
+struct lfq_single_consumer {
+	static constexpr bool multi = false;
+};
+
+// 多消费者：出队通过 CAS 认领 head（MPMC）
+struct lfq_multi_consumer {
+	static constexpr bool multi = true;
+};
+
+// 默认配置：与最初实现行为一致
+struct lfq_default_traits {
+	using index_policy = lfq_modulo_index;
+	using consumer_policy = lfq_single_consumer;
+	using slot_layout = lfq_packed_layout;
+
+	// 生产者缓存 head、消费者缓存 tail，只在缓存显示满/空时才读取对方的缓存行
+	static constexpr bool cache_indices = true;
+
+	// 单消费者每取出多少个元素才发布一次 head_（1 为逐个发布，多消费者时忽略）
+	// 大于1时消费者在私有字段上推进 head，攒满该个数、追上可见的 tail 或出队失败时才写 head_
+	// 生产者看到的空闲空间最多少该个数减一，应远小于容量
+	static constexpr size_t head_publish_interval = 1;
+
+	// enqueue_wait/dequeue_wait 的等待方式（见 lfq_wait.h）
+	using wait_strategy = lfq_spin_yield_wait<>;
+
+	// head/tail 的 CAS 失败后的退避方式（见 lfq_backoff.h），默认立即重试
+	using backoff_policy = lfq_no_backoff;
+
+	// 热路径统计（见 lfq_stats.h），默认不统计
+#ifdef LFQ_ENABLE_STATS
+	using stats_policy = lfq_thread_stats;
+#else
+	using stats_policy = lfq_no_stats;
+#endif
+
+	// 入队到出队的驻留时间采样（见 lfq_latency.h），默认不采样
+	using latency_policy = lfq_no_latency;
+
+	// 槽位缓冲区的分配方式（见 lfq_alloc.h），lfq_hugepage_allocator 使用大页并可绑定 NUMA 节点
+	using allocator = lfq_new_allocator;
+};
+
+// 2的幂容量配置
+struct lfq_pow2_traits : lfq_default_traits {
+	using index_policy = lfq_pow2_index;
+};
+
+// 多生产者多消费者配置
+struct lfq_mpmc_traits : lfq_pow2_traits {
+	using consumer_policy = lfq_multi_consumer;
+};
@@ -0,0 +1,288 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+#include "lfq_traits.h"
+#include "lfq_layout.h"
+#include "lfq_storage.h"
+#include "lfq_epoch.h"
+
+// 无界队列：由固定大小的数组段串成链表
+// 段内与 lfq_array_based 相同，生产者 CAS 认领 tail、槽位带 ready 标志；段写满时追加新段
+// 消费者取完一段后把它摘下，经纪元回收（lfq_epoch_domain）确认无人访问后放回空闲链表复用
+// 入队只在内存耗尽时失败（抛出 std::bad_alloc），不需要满队列时的退让/丢弃
+// Traits::consumer_policy 选择单消费者或多消费者，Traits::slot_layout 作用于段内槽位
+// 构造参数为预分配的容量，空闲链表至少保留这么多段，突发过后多余的段被释放
+template <typename T, size_t SegmentSize = 1024, typename Traits = lfq_default_traits>
+class lfq_unbounded {
+	static_assert(SegmentSize > 0, "Segment size must be greater than zero.");
+
+public:
+	using consumer_type = typename Traits::consumer_policy;
+	using layout_type = typename Traits::slot_layout;
+
+	explicit lfq_unbounded(size_t reserve = SegmentSize);
+
+	lfq_unbounded(const lfq_unbounded&) = delete;
+	lfq_unbounded& operator=(const lfq_unbounded&) = delete;
+
+	// 总是成功，返回 bool 以便与有界队列互换
+	bool enqueue(const T& value);
+
+	bool enqueue(T&& value);
+
+	template <typename... Args>
+	bool emplace(Args&&... args);
+
+	bool dequeue(T& value);
+
+	bool empty() const;
+
+	// 析构队列中剩余的元素并释放全部段
+	~lfq_unbounded();
+
+private:
+	static constexpr size_t slot_align_ = alignof(T) > layout_type::align ? alignof(T) : layout_type::align;
+
+	struct alignas(slot_align_) Slot {
+		lfq_storage<T> data;
+		std::atomic<bool> ready = false; // 本段生命期内只由 false 变为 true，回收时统一清零
+	};
+	using map_type = typename layout_type::template mapper<sizeof(Slot)>;
+
+	struct Segment {
+		alignas(64) std::atomic<uint64_t> head{ 0 };	// 段内出队位置
+		alignas(64) std::atomic<uint64_t> tail{ 0 };	// 段内入队位置（写满后停在 SegmentSize）
+		std::atomic<Segment*> next{ nullptr };
+		Segment* retired_next = nullptr;	// 纪元回收链表
+		uint64_t retired_epoch = 0;
+		Segment* free_next = nullptr;		// 空闲链表
+		Slot slots[SegmentSize];
+
+		// 放回空闲链表前恢复初始状态（此时没有任何线程访问）
+		void reset() {
+			head.store(0, std::memory_order_relaxed);
+			tail.store(0, std::memory_order_relaxed);
+			next.store(nullptr, std::memory_order_relaxed);
+			for (Slot& slot : slots)
+				slot.ready.store(false, std::memory_order_relaxed);
+		}
+	};
+
+	const map_type map_;		// 段内槽位下标重排（布局策略）
+	size_t max_free_;			// 空闲链表保留的段数上限
+	alignas(64) std::atomic<Segment*> head_seg_;	// 消费者所在的段
+	alignas(64) std::atomic<Segment*> tail_seg_;	// 生产者所在的段
+	alignas(64) std::atomic<Segment*> free_{ nullptr };		// 空闲段（栈）
+	std::atomic<size_t> free_count_{ 0 };					// 空闲段个数（近似）
+	mutable lfq_epoch_domain<Segment> epoch_;
+
+	// 从空闲链表取一段，没有时新分配
+	Segment* allocate_segment();
+
+	// 归还一段：空闲链表未满时复用，否则释放
+	void free_segment(Segment* seg);
+
+	Segment* pop_free();
+
+	void push_free(Segment* first, Segment* last);
+};
+
+template <typename T, size_t SegmentSize, typename Traits>
+lfq_unbounded<T, SegmentSize, Traits>::lfq_unbounded(size_t reserve)
+	: map_(SegmentSize),
+	max_free_(reserve / SegmentSize + 1),
+	head_seg_(nullptr),
+	tail_seg_(nullptr) {
+	Segment* first = new Segment;
+	head_seg_.store(first, std::memory_order_relaxed);
+	tail_seg_.store(first, std::memory_order_relaxed);
+
+	// 预分配：首段之外再准备 reserve 所需的段
+	for (size_t n = SegmentSize; n < reserve; n += SegmentSize) {
+		Segment* seg = new Segment;
+		push_free(seg, seg);
+		free_count_.fetch_add(1, std::memory_order_relaxed);
+	}
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+lfq_unbounded<T, SegmentSize, Traits>::~lfq_unbounded() {
+	// 此时不应再有并发操作：各段 [head, tail) 中为尚未取走的元素
+	Segment* seg = head_seg_.load(std::memory_order_acquire);
+	while (seg) {
+		uint64_t const tail = seg->tail.load(std::memory_order_relaxed);
+		for (uint64_t i = seg->head.load(std::memory_order_relaxed); i < tail && i < SegmentSize; ++i) {
+			Slot& slot = seg->slots[map_(i)];
+			if (slot.ready.load(std::memory_order_acquire))
+				slot.data.destroy();
+		}
+		Segment* next = seg->next.load(std::memory_order_relaxed);
+		delete seg;
+		seg = next;
+	}
+
+	epoch_.clear([](Segment* s) { delete s; });
+
+	seg = free_.load(std::memory_order_acquire);
+	while (seg) {
+		Segment* next = seg->free_next;
+		delete seg;
+		seg = next;
+	}
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+bool lfq_unbounded<T, SegmentSize, Traits>::enqueue(const T& value) {
+	return emplace(value);
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+bool lfq_unbounded<T, SegmentSize, Traits>::enqueue(T&& value) {
+	return emplace(std::move(value));
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+template <typename... Args>
+bool lfq_unbounded<T, SegmentSize, Traits>::emplace(Args&&... args) {
+	auto const guard = epoch_.pin();
+
+	for (;;) {
+		Segment* seg = tail_seg_.load(std::memory_order_seq_cst);
+
+		// 1. 在当前段内认领槽位（与有界队列的快速路径相同）
+		uint64_t tail = seg->tail.load(std::memory_order_relaxed);
+		while (tail < SegmentSize) {
+			if (seg->tail.compare_exchange_weak(
+				tail,
+				tail + 1,
+				std::memory_order_acq_rel,
+				std::memory_order_relaxed)) {
+				// 2. 原地构造元素并发布
+				Slot& slot = seg->slots[map_(tail)];
+				slot.data.construct(std::forward<Args>(args)...);
+				slot.ready.store(true, std::memory_order_release);
+				return true;
+			}
+		}
+
+		// 3. 本段已满：追加新段（只有一个生产者能挂上，其余的归还）
+		Segment* next = seg->next.load(std::memory_order_acquire);
+		if (next == nullptr) {
+			Segment* fresh = allocate_segment();
+			if (seg->next.compare_exchange_strong(next, fresh, std::memory_order_acq_rel, std::memory_order_acquire))
+				next = fresh;
+			else
+				free_segment(fresh);
+		}
+
+		// 4. 推进 tail_seg_（失败说明已被其他线程推进）
+		tail_seg_.compare_exchange_strong(seg, next, std::memory_order_seq_cst);
+	}
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+bool lfq_unbounded<T, SegmentSize, Traits>::dequeue(T& value) {
+	auto const guard = epoch_.pin();
+
+	for (;;) {
+		Segment* seg = head_seg_.load(std::memory_order_seq_cst);
+
+		// 1. 段内取元素：未认领的槽位 ready 为 false，不必读取 tail
+		uint64_t head = seg->head.load(std::memory_order_relaxed);
+		while (head < SegmentSize) {
+			Slot& slot = seg->slots[map_(head)];
+			if (!slot.ready.load(std::memory_order_acquire)) {
+				return false; // 队列为空，或生产者已认领但尚未写完
+			}
+
+			if constexpr (consumer_type::multi) {
+				if (!seg->head.compare_exchange_weak(
+					head,
+					head + 1,
+					std::memory_order_acq_rel,
+					std::memory_order_relaxed))
+					continue;
+				slot.data.move_to(value);
+			}
+			else {
+				slot.data.move_to(value);
+				seg->head.store(head + 1, std::memory_order_release);
+			}
+			return true;
+		}
+
+		// 2. 本段已取完：没有后继段说明队列为空
+		Segment* next = seg->next.load(std::memory_order_acquire);
+		if (next == nullptr) {
+			return false;
+		}
+
+		// 3. 摘下本段：先保证 tail_seg_ 不再指向它，再推进 head_seg_
+		Segment* expected = seg;
+		tail_seg_.compare_exchange_strong(expected, next, std::memory_order_seq_cst);
+		if (head_seg_.compare_exchange_strong(seg, next, std::memory_order_seq_cst)) {
+			epoch_.retire(seg);
+			epoch_.reclaim([this](Segment* s) { free_segment(s); });
+		}
+	}
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+bool lfq_unbounded<T, SegmentSize, Traits>::empty() const {
+	// 松散判空，只作参考（与有界队列一致，已认领但尚未写完的元素也算非空）
+	// 不能只看 head 处的 ready：该槽位的生产者尚未写完时，后面的槽位可能已经发布
+	// 先以 acquire 读取 head，随后读到的段内 tail 不会比 head 旧
+	auto const guard = epoch_.pin();
+	Segment* seg = head_seg_.load(std::memory_order_seq_cst);
+	uint64_t const head = seg->head.load(std::memory_order_acquire);
+	if (head < SegmentSize)
+		return seg->tail.load(std::memory_order_relaxed) <= head;
+	return seg->next.load(std::memory_order_relaxed) == nullptr;
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+typename lfq_unbounded<T, SegmentSize, Traits>::Segment* lfq_unbounded<T, SegmentSize, Traits>::allocate_segment() {
+	Segment* seg = pop_free();
+	if (seg)
+		return seg;
+	return new Segment;
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+void lfq_unbounded<T, SegmentSize, Traits>::free_segment(Segment* seg) {
+	if (free_count_.load(std::memory_order_relaxed) >= max_free_) {
+		delete seg;
+		return;
+	}
+	seg->reset();
+	free_count_.fetch_add(1, std::memory_order_relaxed);
+	push_free(seg, seg);
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+typename lfq_unbounded<T, SegmentSize, Traits>::Segment* lfq_unbounded<T, SegmentSize, Traits>::pop_free() {
+	// 整体取走再放回其余部分，避免 Treiber 栈弹出时的 ABA
+	Segment* list = free_.exchange(nullptr, std::memory_order_acquire);
+	if (!list)
+		return nullptr;
+
+	if (Segment* rest = list->free_next) {
+		Segment* last = rest;
+		while (last->free_next)
+			last = last->free_next;
+		push_free(rest, last);
+	}
+	list->free_next = nullptr;
+	free_count_.fetch_sub(1, std::memory_order_relaxed);
+	return list;
+}
+
+template <typename T, size_t SegmentSize, typename Traits>
+void lfq_unbounded<T, SegmentSize, Traits>::push_free(Segment* first, Segment* last) {
+	Segment* top = free_.load(std::memory_order_relaxed);
+	do {
+		last->free_next = top;
+	} while (!free_.compare_exchange_weak(top, first, std::memory_order_release, std::memory_order_relaxed));
+}
@@ -0,0 +1,170 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <thread>
+
+#include "lfq_common.h"
+
+#if defined(__linux__)
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#include <ctime>
+#elif defined(_WIN32)
+#ifndef NOMINMAX
+#define NOMINMAX
+#endif
+#include <windows.h>
+#pragma comment(lib, "Synchronization.lib")
+#endif
+
+// 等待策略：dequeue_wait/enqueue_wait 在队列空/满时如何等待
+// 每个策略对象提供
+//   bool wait_until(pred, deadline)  反复调用 pred()（即一次 try 操作），成功返回 true，超时返回 false
+//   void notify()                    对端完成一次操作后调用，条件可能已满足
+// 自旋类策略的 notify() 为空函数，不给快速路径增加任何开销
+
+using lfq_clock = std::chrono::steady_clock;
+
+// 超时 -> 截止时间（超时过大时饱和到 time_point::max()，不大于0时为当前时刻）
+// 先在 long double 纳秒下比较，再转换已确认不会越界的值；不能把剩余时间转换为调用方的 Rep，窄类型时会溢出
+template <typename Rep, typename Period>
+lfq_clock::time_point lfq_deadline(const std::chrono::duration<Rep, Period>& timeout) {
+	using wide = std::chrono::duration<long double, std::nano>;
+	auto const now = lfq_clock::now();
+	wide const wanted(timeout);
+	if (wanted <= wide::zero())
+		return now;
+	if (wanted >= wide(lfq_clock::time_point::max() - now))
+		return lfq_clock::time_point::max();
+	return now + std::chrono::duration_cast<lfq_clock::duration>(timeout);
+}
+
+// 忙等：只用 pause 自旋，延迟最低，空闲时占满一个核
+struct lfq_busy_spin_wait {
+	template <typename Pred>
+	bool wait_until(Pred&& pred, lfq_clock::time_point deadline) {
+		for (unsigned n = 0;; ++n) {
+			if (pred())
+				return true;
+			// 每64次检查一次时钟，减少读时钟的开销
+			if ((n & 63) == 63 && lfq_clock::now() >= deadline)
+				return false;
+			lfq_cpu_relax();
+		}
+	}
+
+	void notify() noexcept {}
+};
+
+// 先自旋 SpinLimit 次，之后每次失败都让出时间片
+template <unsigned SpinLimit = 1024>
+struct lfq_spin_yield_wait {
+	template <typename Pred>
+	bool wait_until(Pred&& pred, lfq_clock::time_point deadline) {
+		for (unsigned n = 0;; ++n) {
+			if (pred())
+				return true;
+			if (n < SpinLimit) {
+				if ((n & 63) == 63 && lfq_clock::now() >= deadline)
+					return false;
+				lfq_cpu_relax();
+			}
+			else {
+				if (lfq_clock::now() >= deadline)
+					return false;
+				std::this_thread::yield();
+			}
+		}
+	}
+
+	void notify() noexcept {}
+};
+
+// 在 addr 上等待，直到 *addr != expected、被唤醒或超时（允许虚假唤醒）
+inline void lfq_futex_wait(std::atomic<uint32_t>& addr, uint32_t expected, std::chrono::nanoseconds timeout) {
+	static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t), "futex needs a plain 32-bit word");
+	if (timeout.count() <= 0)
+		return;
+#if defined(__linux__)
+	timespec ts;
+	ts.tv_sec = static_cast<time_t>(timeout.count() / 1000000000);
+	ts.tv_nsec = static_cast<long>(timeout.count() % 1000000000);
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&addr), FUTEX_WAIT_PRIVATE, expected, &ts, nullptr, 0);
+#elif defined(_WIN32)
+	DWORD const ms = static_cast<DWORD>(std::chrono::ceil<std::chrono::milliseconds>(timeout).count());
+	WaitOnAddress(reinterpret_cast<volatile VOID*>(&addr), &expected, sizeof(expected), ms);
+#else
+	// 没有等待原语的平台：短暂休眠后由调用方重新检查
+	if (addr.load(std::memory_order_acquire) == expected)
+		std::this_thread::sleep_for(std::min<std::chrono::nanoseconds>(timeout, std::chrono::microseconds(50)));
+#endif
+}
+
+// 唤醒在 addr 上等待的全部线程
+inline void lfq_futex_wake_all(std::atomic<uint32_t>& addr) {
+#if defined(__linux__)
+	syscall(SYS_futex, reinterpret_cast<uint32_t*>(&addr), FUTEX_WAKE_PRIVATE, INT32_MAX, nullptr, nullptr, 0);
+#elif defined(_WIN32)
+	WakeByAddressAll(reinterpret_cast<PVOID>(&addr));
+#else
+	(void)addr;
+#endif
+}
+
+// 先自旋，仍不满足则挂起（Linux futex / Windows WaitOnAddress）
+// notify() 只有在确有等待者登记时才发起唤醒系统调用
+template <unsigned SpinLimit = 256>
+class lfq_park_wait {
+public:
+	template <typename Pred>
+	bool wait_until(Pred&& pred, lfq_clock::time_point deadline) {
+		// 1. 自旋阶段：负载较高时通常在这里就能成功
+		for (unsigned n = 0; n < SpinLimit; ++n) {
+			if (pred())
+				return true;
+			lfq_cpu_relax();
+		}
+
+		// 2. 挂起阶段
+		for (;;) {
+			uint32_t const epoch = epoch_.load(std::memory_order_acquire);
+
+			// 先登记再检查条件，与 notify() 中的栅栏配对，避免丢失唤醒
+			waiters_.fetch_add(1, std::memory_order_seq_cst);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			if (pred()) {
+				waiters_.fetch_sub(1, std::memory_order_relaxed);
+				return true;
+			}
+
+			auto const now = lfq_clock::now();
+			if (now >= deadline) {
+				waiters_.fetch_sub(1, std::memory_order_relaxed);
+				return false;
+			}
+
+			lfq_futex_wait(epoch_, epoch, deadline - now);
+			waiters_.fetch_sub(1, std::memory_order_relaxed);
+
+			if (pred())
+				return true;
+		}
+	}
+
+	void notify() noexcept {
+		// 与等待方的登记配对：要么等待方看到新数据，要么这里看到等待者
+		std::atomic_thread_fence(std::memory_order_seq_cst);
+		if (waiters_.load(std::memory_order_relaxed) != 0) {
+			epoch_.fetch_add(1, std::memory_order_release);
+			lfq_futex_wake_all(epoch_);
+		}
+	}
+
+private:
+	std::atomic<uint32_t> epoch_{ 0 };		// 每次唤醒加一，作为 futex 的比较值
+	std::atomic<uint32_t> waiters_{ 0 };	// 已登记的等待者个数
+};
@@ -5,22 +5,23 @@
 #include <mutex>
 #include <random>
 #include <cassert>
+#include <algorithm>
 
 #include <lfq_array_based.h>
 
-// ʵ֣ԣ
+// 包含队列实现（略）
 // #include "lfq_array_based.hpp" 
 
 using namespace std;
 
-// ̻߳ܲ
+// 单线程基本功能测试
 void test_basic_functionality() {
     cout << "===== Basic Functionality Test =====" << endl;
     lfq_array_based<int> queue(5);
 
     assert(queue.empty());
 
-    // /Ӳ
+    // 基础入队/出队测试
     assert(queue.enqueue(1));
     assert(queue.enqueue(2));
     assert(!queue.empty());
@@ -31,15 +32,15 @@ void test_basic_functionality() {
     assert(queue.empty());
     assert(!queue.dequeue(val));
 
-    // в
-    for (int i = 0; i < 4; ++i)  // 5ʵʿ4λ
+    // 满队列测试
+    for (int i = 0; i < 4; ++i)  // 容量5实际可用4个位置
         assert(queue.enqueue(i));
-    assert(!queue.enqueue(10));  // Ӧʧ
+    assert(!queue.enqueue(10));  // 应失败
 
     cout << "Basic tests passed!\n" << endl;
 }
 
-// ߵ߲ (MPSC)
+// 多生产者单消费者测试 (MPSC)
 void test_mpsc() {
     cout << "===== MPSC Test =====" << endl;
     const size_t capacity = 100;
@@ -52,28 +53,28 @@ void test_mpsc() {
     vector<int> consumer_items;
     mutex consumer_mtx;
 
-    // 
+    // 创建生产者
     for (size_t i = 0; i < num_producers; ++i) {
         producers.emplace_back([&, i] {
-            // ȴʼź
+            // 等待开始信号
             while (!start_flag.load(memory_order_acquire))
                 this_thread::yield();
 
-            // ÿдضΧ
+            // 每个生产者写入特定范围的数字
             for (size_t j = 0; j < items_per_producer; ++j) {
                 int item = static_cast<int>(i * items_per_producer + j);
                 while (!queue.enqueue(item))
-                    this_thread::yield(); // ʱȴ
+                    this_thread::yield(); // 队列满时等待
             }
             });
     }
 
-    // 
+    // 创建消费者
     thread consumer([&] {
         size_t total_items = num_producers * items_per_producer;
         for (size_t i = 0; i < total_items; ++i) {
             int val;
-            while (!queue.dequeue(val))  // пʱȴ
+            while (!queue.dequeue(val))  // 队列空时等待
                 this_thread::yield();
 
             lock_guard<mutex> lock(consumer_mtx);
@@ -81,21 +82,21 @@ void test_mpsc() {
         }
         });
 
-    // 
+    // 启动测试
     start_flag.store(true, memory_order_release);
 
-    // ȴ߳̽
+    // 等待线程结束
     for (auto& p : producers) p.join();
     consumer.join();
 
-    // ֤
+    // 验证结果
     assert(consumer_items.size() == num_producers * items_per_producer);
     assert(queue.empty());
 
-    // ֤ݶʧ/ظ
+    // 验证无数据丢失/重复
     vector<bool> items_present(num_producers * items_per_producer, false);
     for (int item : consumer_items) {
-        assert(!items_present[item]);  // ظ
+        assert(!items_present[item]);  // 检测重复
         /*if (items_present[item])
             cout << item << endl;*/
         items_present[item] = true;
@@ -105,39 +106,39 @@ void test_mpsc() {
     cout << "MPSC test passed! Items: " << consumer_items.size() << "\n" << endl;
 }
 
-// ʱ߾
+// 队列满时生产者竞争测试
 void test_full_queue_contention() {
     cout << "===== Full Queue Contention Test =====" << endl;
-    const size_t capacity = 10;  // С쾺
+    const size_t capacity = 10;  // 小容量制造竞争
     lfq_array_based<int> queue(capacity);
 
     const size_t num_threads = 4;
     atomic<int> failed_enqueues{ 0 };
     vector<thread> threads;
 
-    // 䲿ֶУʣ1λʵΪ capacity-1
+    // 填充部分队列（剩1空位）（队列实际容量为 capacity-1）
     for (int i = 0; i < capacity - 2; ++i)
         queue.enqueue(i);
 
-    // ߳
+    // 创建竞争线程
     for (size_t i = 0; i < num_threads; ++i) {
         threads.emplace_back([&] {
-            int v = 100;  // ̶ֵ߳
+            int v = 100;  // 所有线程都尝试入队这个值
             if (!queue.enqueue(v))
                 failed_enqueues.fetch_add(1, memory_order_relaxed);
             });
     }
 
-    // ȴ߳̽
+    // 等待线程结束
     for (auto& t : threads) t.join();
 
-    // ֻ֤һ̳߳ɹ
+    // 验证只有一个线程成功
     assert(failed_enqueues.load() == num_threads - 1);
 
     cout << "Full queue contention test passed!\n" << endl;
 }
 
-// ƶ쳣ȫ
+// 移动语义和异常安全测试
 void test_move_semantics() {
     cout << "===== Move Semantics Test =====" << endl;
     struct MoveTracker {
@@ -157,24 +158,24 @@ void test_move_semantics() {
             return *this;
         }
 
-		MoveTracker() = default;  // ĬϹ
+		MoveTracker() = default;  // 默认构造
         MoveTracker(const MoveTracker&) = delete;
         MoveTracker& operator=(const MoveTracker&) = delete;
     };
 
     lfq_array_based<MoveTracker> queue(5);
 
-    // ƶ
+    // 测试移动构造
     MoveTracker obj1(100);
     queue.enqueue(std::move(obj1));
     assert(obj1.moved_from);
 
-    // ƶֵ
+    // 测试移动赋值
     MoveTracker obj2(200);
     queue.enqueue(static_cast<MoveTracker&&>(obj2));
     assert(obj2.moved_from);
 
-    // Գƶ
+    // 测试出队移动
     MoveTracker dest(0);
     assert(queue.dequeue(dest));
     assert(dest.id == 100 && !dest.moved_from);
@@ -0,0 +1,102 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+using pow2_queue = lfq_array_based<int, lfq_pow2_traits>;
+
+// 2的幂容量：向上取整且全部槽位可用
+void test_pow2_capacity() {
+    cout << "===== Pow2 Capacity Test =====" << endl;
+    pow2_queue queue(5);  // 取整为8
+    assert(queue.capacity() == 8);
+
+    for (int i = 0; i < 8; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(8));  // 8个槽位全部可用后才满
+
+    int val;
+    for (int i = 0; i < 8; ++i)
+        assert(queue.dequeue(val) && val == i);
+    assert(queue.empty());
+    assert(!queue.dequeue(val));
+
+    // 默认取模模式仍保留一个空槽
+    lfq_array_based<int> modulo(5);
+    assert(modulo.capacity() == 4);
+
+    cout << "Pow2 capacity test passed!\n" << endl;
+}
+
+// 多圈回绕：单调序号经掩码映射后顺序不变
+void test_wraparound() {
+    cout << "===== Wraparound Test =====" << endl;
+    pow2_queue queue(4);
+    int next_in = 0, next_out = 0;
+    for (int round = 0; round < 1000; ++round) {
+        int n = round % 4 + 1;
+        for (int i = 0; i < n; ++i)
+            assert(queue.enqueue(next_in++));
+        int val;
+        for (int i = 0; i < n; ++i) {
+            assert(queue.dequeue(val));
+            assert(val == next_out++);
+        }
+        assert(queue.empty());
+    }
+    cout << "Wraparound test passed!\n" << endl;
+}
+
+// 多生产者单消费者
+void test_pow2_mpsc() {
+    cout << "===== Pow2 MPSC Test =====" << endl;
+    const size_t num_producers = 4;
+    const size_t items_per_producer = 5000;
+    pow2_queue queue(64);
+
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                int item = static_cast<int>(i * items_per_producer + j);
+                while (!queue.enqueue(item))
+                    this_thread::yield();
+            }
+            });
+    }
+
+    // 每个生产者内部保持FIFO
+    vector<int> last(num_producers, -1);
+    vector<bool> seen(num_producers * items_per_producer, false);
+    for (size_t n = 0; n < num_producers * items_per_producer; ++n) {
+        int val;
+        while (!queue.dequeue(val))
+            this_thread::yield();
+        size_t p = val / items_per_producer;
+        assert(last[p] < val);
+        last[p] = val;
+        assert(!seen[val]);
+        seen[val] = true;
+    }
+
+    for (auto& p : producers) p.join();
+    assert(queue.empty());
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+
+    cout << "Pow2 MPSC test passed!\n" << endl;
+}
+
+int main() {
+    test_pow2_capacity();
+    test_wraparound();
+    test_pow2_mpsc();
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
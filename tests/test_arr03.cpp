@@ -0,0 +1,120 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+// 多消费者 + 取模索引
+struct modulo_mpmc_traits : lfq_default_traits {
+    using consumer_policy = lfq_multi_consumer;
+};
+
+// 单线程基本功能
+void test_basic_functionality() {
+    cout << "===== MPMC Basic Functionality Test =====" << endl;
+    lfq_array_based<int, lfq_mpmc_traits> queue(4);
+
+    assert(queue.empty());
+    for (int i = 0; i < 4; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(4));
+
+    int val;
+    for (int i = 0; i < 4; ++i)
+        assert(queue.dequeue(val) && val == i);
+    assert(!queue.dequeue(val));
+    assert(queue.empty());
+
+    cout << "MPMC basic tests passed!\n" << endl;
+}
+
+// 多生产者多消费者压力测试
+// 检查：无丢失、无重复、同一生产者的数据在每个消费者处保持顺序
+template <typename Queue>
+void stress(const char* name, size_t capacity, size_t num_producers, size_t num_consumers,
+    size_t items_per_producer) {
+    cout << "===== MPMC Stress Test: " << name << " cap=" << capacity
+        << " p=" << num_producers << " c=" << num_consumers << " =====" << endl;
+    const size_t total = num_producers * items_per_producer;
+    Queue queue(capacity);
+
+    atomic<bool> start_flag{ false };
+    atomic<size_t> consumed{ 0 };
+    vector<vector<string>> received(num_consumers);
+    vector<thread> threads;
+
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            while (!start_flag.load(memory_order_acquire))
+                this_thread::yield();
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                // 使用 string 负载，读到未写完或已被移走的数据会立即暴露
+                string item = to_string(i * items_per_producer + j);
+                while (!queue.enqueue(item))
+                    this_thread::yield();
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            while (!start_flag.load(memory_order_acquire))
+                this_thread::yield();
+            string val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val)) {
+                    received[c].push_back(val);
+                    consumed.fetch_add(1, memory_order_relaxed);
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+            });
+    }
+
+    start_flag.store(true, memory_order_release);
+    for (auto& t : threads) t.join();
+
+    vector<bool> seen(total, false);
+    size_t count = 0;
+    for (auto& items : received) {
+        vector<long long> last(num_producers, -1);
+        for (const string& s : items) {
+            assert(!s.empty());
+            size_t item = stoull(s);
+            assert(item < total);
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < static_cast<long long>(item));
+            last[p] = static_cast<long long>(item);
+            ++count;
+        }
+    }
+    assert(count == total);
+    assert(queue.empty());
+
+    cout << "Passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+
+    using pow2_mpmc = lfq_array_based<string, lfq_mpmc_traits>;
+    using modulo_mpmc = lfq_array_based<string, modulo_mpmc_traits>;
+
+    stress<pow2_mpmc>("pow2", 2, 2, 2, 5000);
+    stress<pow2_mpmc>("pow2", 64, 4, 4, 5000);
+    stress<pow2_mpmc>("pow2", 1024, 8, 3, 2000);
+    stress<modulo_mpmc>("modulo", 3, 3, 3, 5000);
+    stress<modulo_mpmc>("modulo", 100, 4, 4, 5000);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
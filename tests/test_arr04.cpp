@@ -0,0 +1,101 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+struct pad64_traits : lfq_pow2_traits {
+    using slot_layout = lfq_padded_layout<64>;
+};
+
+struct pad128_traits : lfq_pow2_traits {
+    using slot_layout = lfq_padded_layout<128>;
+};
+
+struct remap_traits : lfq_pow2_traits {
+    using slot_layout = lfq_remap_layout;
+};
+
+// 重排映射必须是槽位下标上的双射，且连续下标落在不同缓存行
+void test_remap_mapper() {
+    cout << "===== Remap Mapper Test =====" << endl;
+    const size_t slots = 1024;
+    const size_t slot_size = 8;  // 每行8个槽位
+    lfq_remap_layout::mapper<slot_size> map(slots);
+
+    vector<bool> hit(slots, false);
+    for (size_t i = 0; i < slots; ++i) {
+        size_t m = map(i);
+        assert(m < slots);
+        assert(!hit[m]);
+        hit[m] = true;
+        if (i > 0)
+            assert(map(i) / (lfq_cache_line / slot_size) != map(i - 1) / (lfq_cache_line / slot_size));
+    }
+
+    // 槽位数不是2的幂或太小时退化为恒等映射
+    lfq_remap_layout::mapper<slot_size> small(8);
+    lfq_remap_layout::mapper<slot_size> odd(100);
+    for (size_t i = 0; i < 8; ++i)
+        assert(small(i) == i && odd(i) == i);
+
+    cout << "Remap mapper test passed!\n" << endl;
+}
+
+// 各布局下的功能与多生产者正确性
+template <typename Traits>
+void test_layout(const char* name) {
+    cout << "===== Layout Test: " << name << " =====" << endl;
+    {
+        lfq_array_based<int, Traits> queue(64);
+        for (int round = 0; round < 10; ++round) {
+            for (int i = 0; i < 64; ++i)
+                assert(queue.enqueue(i));
+            assert(!queue.enqueue(64));
+            int val;
+            for (int i = 0; i < 64; ++i)
+                assert(queue.dequeue(val) && val == i);
+            assert(queue.empty());
+        }
+    }
+
+    const size_t num_producers = 4;
+    const size_t items_per_producer = 5000;
+    lfq_array_based<int, Traits> queue(128);
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j)
+                while (!queue.enqueue(static_cast<int>(i * items_per_producer + j)))
+                    this_thread::yield();
+            });
+    }
+
+    vector<int> last(num_producers, -1);
+    for (size_t n = 0; n < num_producers * items_per_producer; ++n) {
+        int val;
+        while (!queue.dequeue(val))
+            this_thread::yield();
+        size_t p = val / items_per_producer;
+        assert(last[p] < val);
+        last[p] = val;
+    }
+    for (auto& p : producers) p.join();
+    assert(queue.empty());
+
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_remap_mapper();
+    test_layout<pad64_traits>("padded 64");
+    test_layout<pad128_traits>("padded 128");
+    test_layout<remap_traits>("remap");
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
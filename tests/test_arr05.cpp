@@ -0,0 +1,146 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cassert>
+#include <algorithm>
+#include <cstdint>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+// 单线程批量接口语义
+void test_bulk_basic() {
+    cout << "===== Bulk Basic Test =====" << endl;
+    lfq_array_based<int, lfq_pow2_traits> queue(8);
+    vector<int> in = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 9 };
+    vector<int> out(10, -1);
+
+    assert(queue.enqueue_bulk(in.begin(), 0));
+    assert(queue.enqueue_bulk(in.begin(), 5));
+    assert(!queue.enqueue_bulk(in.begin() + 5, 4));  // 只剩3个位置：全部失败
+    assert(queue.enqueue_bulk(in.begin() + 5, 3));
+    assert(!queue.enqueue(100));
+
+    // 部分出队
+    assert(queue.dequeue_bulk(out.begin(), 3) == 3);
+    assert(out[0] == 0 && out[1] == 1 && out[2] == 2);
+
+    // 与单个接口混用
+    int val;
+    assert(queue.dequeue(val) && val == 3);
+    assert(queue.enqueue(8) && queue.enqueue(9));
+
+    size_t n = queue.dequeue_bulk(out.begin(), 100);
+    assert(n == 6);
+    for (size_t i = 0; i < n; ++i)
+        assert(out[i] == static_cast<int>(i) + 4);
+    assert(queue.dequeue_bulk(out.begin(), 100) == 0);
+    assert(queue.empty());
+
+    // 取模模式
+    lfq_array_based<int> modulo(5);
+    assert(!modulo.enqueue_bulk(in.begin(), 5));
+    assert(modulo.enqueue_bulk(in.begin(), 4));
+    assert(modulo.dequeue_bulk(out.begin(), 4) == 4);
+    assert(out[3] == 3);
+
+    cout << "Bulk basic tests passed!\n" << endl;
+}
+
+// 请求个数超过容量（如 SIZE_MAX 表示全部取出）时按容量判断缓存的 tail，过期的缓存不会挡住重新读取
+template <typename Traits>
+void test_bulk_take_all(const char* name) {
+    cout << "===== Bulk Take All Test: " << name << " =====" << endl;
+    lfq_array_based<int, Traits> queue(8);
+    vector<int> out(8, -1);
+    bool ok = true;
+
+    for (int round = 0; round < 3; ++round) {
+        ok = queue.enqueue(round * 2);
+        ok = queue.enqueue(round * 2 + 1) && ok;
+        assert(ok);
+        size_t n = queue.dequeue_bulk(out.begin(), SIZE_MAX);
+        assert(n == 2);
+        assert(out[0] == round * 2 && out[1] == round * 2 + 1);
+        n = queue.dequeue_bulk(out.begin(), SIZE_MAX);
+        assert(n == 0);
+    }
+
+    // 超过容量的批量入队整批失败
+    ok = queue.enqueue_bulk(out.begin(), SIZE_MAX);
+    assert(!ok);
+    assert(queue.empty());
+
+    cout << "Bulk take all tests passed!\n" << endl;
+}
+
+// 多生产者批量写入，消费者批量读取
+template <typename Traits>
+void test_bulk_concurrent(const char* name, size_t num_consumers) {
+    cout << "===== Bulk Concurrent Test: " << name << " =====" << endl;
+    const size_t num_producers = 4;
+    const size_t items_per_producer = 8000;
+    const size_t batch = 16;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_based<int, Traits> queue(256);
+
+    atomic<size_t> consumed{ 0 };
+    vector<vector<int>> received(num_consumers);
+    vector<thread> threads;
+
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            vector<int> items(batch);
+            for (size_t j = 0; j < items_per_producer; j += batch) {
+                for (size_t k = 0; k < batch; ++k)
+                    items[k] = static_cast<int>(i * items_per_producer + j + k);
+                while (!queue.enqueue_bulk(items.begin(), batch))
+                    this_thread::yield();
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            vector<int> items(batch * 2);
+            while (consumed.load(memory_order_relaxed) < total) {
+                size_t n = queue.dequeue_bulk(items.begin(), items.size());
+                if (n == 0) {
+                    this_thread::yield();
+                    continue;
+                }
+                received[c].insert(received[c].end(), items.begin(), items.begin() + n);
+                consumed.fetch_add(n, memory_order_relaxed);
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    vector<bool> seen(total, false);
+    for (auto& items : received) {
+        vector<int> last(num_producers, -1);
+        for (int item : items) {
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+    }
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+    assert(queue.empty());
+
+    cout << "Passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_bulk_basic();
+    test_bulk_take_all<lfq_pow2_traits>("pow2");
+    test_bulk_take_all<lfq_default_traits>("modulo");
+    test_bulk_concurrent<lfq_pow2_traits>("mpsc", 1);
+    test_bulk_concurrent<lfq_mpmc_traits>("mpmc", 3);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <cassert>
+#include <algorithm>
+#include <limits>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+using namespace std::chrono;
+
+struct busy_traits : lfq_pow2_traits {
+    using wait_strategy = lfq_busy_spin_wait;
+};
+
+struct yield_traits : lfq_pow2_traits {
+    using wait_strategy = lfq_spin_yield_wait<64>;
+};
+
+struct park_traits : lfq_pow2_traits {
+    using wait_strategy = lfq_park_wait<>;
+};
+
+struct park_mpmc_traits : lfq_mpmc_traits {
+    using wait_strategy = lfq_park_wait<>;
+};
+
+// 超时：空队列出队、满队列入队都应在超时后返回 false
+template <typename Traits>
+void test_timeout(const char* name) {
+    cout << "===== Wait Timeout Test: " << name << " =====" << endl;
+    lfq_array_based<int, Traits> queue(2);
+    int val;
+
+    // 队列操作放在 assert 之外，NDEBUG 下照常执行
+    auto begin = steady_clock::now();
+    bool ok = queue.dequeue_wait(val, milliseconds(20));
+    assert(!ok);
+    assert(steady_clock::now() - begin >= milliseconds(20));
+
+    ok = queue.enqueue_wait(1, milliseconds(20));
+    assert(ok);
+    ok = queue.enqueue_wait(2, milliseconds(20));
+    assert(ok);
+    begin = steady_clock::now();
+    ok = queue.enqueue_wait(3, milliseconds(20));
+    assert(!ok);
+    assert(steady_clock::now() - begin >= milliseconds(20));
+
+    ok = queue.dequeue_wait(val, milliseconds(20));
+    assert(ok && val == 1);
+    ok = queue.dequeue_wait(val, seconds(0));
+    assert(ok && val == 2);
+
+    cout << "Passed!\n" << endl;
+}
+
+// 超时换算为截止时间：窄 Rep 与极大/负的超时都不应溢出
+void test_deadline() {
+    cout << "===== Deadline Conversion Test =====" << endl;
+    auto const before = lfq_clock::now();
+
+    // int32 毫秒的最大值约24天，不饱和
+    auto d = lfq_deadline(duration<int32_t, milli>::max());
+    assert(d > before + hours(24 * 24) && d < lfq_clock::time_point::max());
+
+    // int 秒约68年，仍在 steady_clock 的范围内
+    d = lfq_deadline(duration<int>(numeric_limits<int>::max()));
+    assert(d > before + hours(24 * 365 * 60) && d < lfq_clock::time_point::max());
+
+    // 超出范围时饱和
+    assert(lfq_deadline(seconds::max()) == lfq_clock::time_point::max());
+    assert(lfq_deadline(hours::max()) == lfq_clock::time_point::max());
+    assert(lfq_deadline(lfq_clock::duration::max()) == lfq_clock::time_point::max());
+
+    // 0 与负数为当前时刻
+    d = lfq_deadline(duration<int8_t>(-100));
+    assert(d >= before && d <= lfq_clock::now());
+    d = lfq_deadline(seconds::min());
+    assert(d >= before && d <= lfq_clock::now());
+
+    cout << "Passed!\n" << endl;
+}
+
+// 阻塞的消费者应被生产者唤醒
+template <typename Traits>
+void test_wakeup(const char* name) {
+    cout << "===== Wait Wakeup Test: " << name << " =====" << endl;
+    lfq_array_based<int, Traits> queue(4);
+    atomic<bool> got{ false };
+
+    thread consumer([&] {
+        int val = -1;
+        bool const ok = queue.dequeue_wait(val);  // 无超时
+        assert(ok && val == 42);
+        got.store(true);
+        });
+
+    this_thread::sleep_for(milliseconds(30));
+    assert(!got.load());
+    bool ok = queue.enqueue(42);
+    assert(ok);
+    consumer.join();
+    assert(got.load());
+
+    // 阻塞的生产者应被消费者唤醒
+    for (int i = 0; i < 4; ++i) {
+        ok = queue.enqueue(i);
+        assert(ok);
+    }
+    thread producer([&] {
+        bool const ok = queue.enqueue_wait(100);
+        assert(ok);
+        });
+    this_thread::sleep_for(milliseconds(30));
+    int val;
+    ok = queue.dequeue(val);
+    assert(ok && val == 0);
+    producer.join();
+    for (int i = 1; i < 4; ++i) {
+        ok = queue.dequeue(val);
+        assert(ok && val == i);
+    }
+    ok = queue.dequeue(val);
+    assert(ok && val == 100);
+
+    cout << "Passed!\n" << endl;
+}
+
+// 多生产者多消费者全部使用阻塞接口
+template <typename Traits>
+void test_blocking_stream(const char* name, size_t num_consumers) {
+    cout << "===== Blocking Stream Test: " << name << " =====" << endl;
+    const size_t num_producers = 3;
+    const size_t items_per_producer = 5000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_based<int, Traits> queue(16);
+
+    atomic<size_t> consumed{ 0 };
+    vector<vector<int>> received(num_consumers);
+    vector<thread> threads;
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j)
+                queue.enqueue_wait(static_cast<int>(i * items_per_producer + j));
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            int val;
+            while (consumed.load() < total) {
+                if (queue.dequeue_wait(val, milliseconds(5))) {
+                    received[c].push_back(val);
+                    consumed.fetch_add(1);
+                }
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    vector<bool> seen(total, false);
+    for (auto& items : received)
+        for (int item : items) {
+            assert(!seen[item]);
+            seen[item] = true;
+        }
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_deadline();
+    test_timeout<busy_traits>("busy spin");
+    test_timeout<yield_traits>("spin then yield");
+    test_timeout<park_traits>("park");
+
+    test_wakeup<yield_traits>("spin then yield");
+    test_wakeup<park_traits>("park");
+
+    test_blocking_stream<park_traits>("park mpsc", 1);
+    test_blocking_stream<park_mpmc_traits>("park mpmc", 3);
+    test_blocking_stream<yield_traits>("spin then yield mpsc", 1);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
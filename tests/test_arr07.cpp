@@ -0,0 +1,112 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <cassert>
+
+#include <lfq_array_based.h>
+#include <lfq_array_seq.h>
+#include <lfq_spsc.h>
+
+using namespace std;
+
+// 不可默认构造、统计存活个数的元素类型
+struct Counted {
+    static atomic<int> alive;
+    int id;
+    string payload;
+
+    Counted(int i, string p) : id(i), payload(std::move(p)) { alive.fetch_add(1); }
+    Counted(const Counted& o) : id(o.id), payload(o.payload) { alive.fetch_add(1); }
+    Counted(Counted&& o) noexcept : id(o.id), payload(std::move(o.payload)) { alive.fetch_add(1); }
+    Counted& operator=(const Counted&) = default;
+    Counted& operator=(Counted&&) noexcept = default;
+    ~Counted() { alive.fetch_sub(1); }
+};
+atomic<int> Counted::alive{ 0 };
+
+// 元素生命周期：构造队列不构造元素，出队立即析构，析构队列释放剩余元素
+template <typename Queue>
+void test_lifetime(const char* name) {
+    cout << "===== Storage Lifetime Test: " << name << " =====" << endl;
+    assert(Counted::alive.load() == 0);
+    {
+        Queue queue(1000);
+        assert(Counted::alive.load() == 0);  // 没有为槽位构造任何元素
+
+        assert(queue.emplace(1, "one"));
+        assert(queue.enqueue(Counted(2, "two")));
+        Counted c(3, "three");
+        assert(queue.enqueue(c));
+        assert(Counted::alive.load() == 4);  // 队列中3个 + c
+
+        Counted out(0, "");
+        assert(queue.dequeue(out) && out.id == 1 && out.payload == "one");
+        assert(Counted::alive.load() == 4);  // 队列中2个 + c + out
+        assert(queue.dequeue(out) && out.id == 2 && out.payload == "two");
+        assert(Counted::alive.load() == 3);
+
+        for (int i = 0; i < 10; ++i)
+            assert(queue.emplace(100 + i, string(64, 'x')));
+        assert(Counted::alive.load() == 13);
+    }
+    // 队列析构后剩余的11个元素全部被析构
+    assert(Counted::alive.load() == 0);
+
+    // 出队后槽位不再持有资源
+    {
+        lfq_array_based<shared_ptr<int>> q(4);
+        auto p = make_shared<int>(7);
+        assert(q.enqueue(p));
+        assert(p.use_count() == 2);
+        shared_ptr<int> out;
+        assert(q.dequeue(out));
+        assert(p.use_count() == 2);  // p + out，槽位中的副本已析构
+        out.reset();
+        assert(p.use_count() == 1);
+    }
+
+    cout << "Passed!\n" << endl;
+}
+
+// 多生产者并发下元素个数守恒
+template <typename Queue>
+void test_concurrent_lifetime(const char* name) {
+    cout << "===== Concurrent Lifetime Test: " << name << " =====" << endl;
+    {
+        Queue queue(64);
+        const int num_producers = 3;
+        const int per_producer = 3000;
+        vector<thread> producers;
+        for (int i = 0; i < num_producers; ++i) {
+            producers.emplace_back([&, i] {
+                for (int j = 0; j < per_producer; ++j)
+                    while (!queue.emplace(i * per_producer + j, to_string(j)))
+                        this_thread::yield();
+                });
+        }
+        Counted out(0, "");
+        // 留下一部分元素交给析构函数处理
+        for (int n = 0; n < num_producers * per_producer - 20; ++n)
+            while (!queue.dequeue(out))
+                this_thread::yield();
+        for (auto& p : producers) p.join();
+    }
+    assert(Counted::alive.load() == 0);
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_lifetime<lfq_array_based<Counted>>("array_based");
+    test_lifetime<lfq_array_based<Counted, lfq_mpmc_traits>>("array_based mpmc");
+    test_lifetime<lfq_array_seq<Counted>>("array_seq");
+    test_lifetime<lfq_spsc<Counted>>("spsc");
+
+    test_concurrent_lifetime<lfq_array_based<Counted, lfq_pow2_traits>>("array_based");
+    test_concurrent_lifetime<lfq_array_seq<Counted>>("array_seq");
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
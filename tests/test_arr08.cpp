@@ -0,0 +1,196 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstring>
+#include <cstdint>
+#include <string>
+#include <cassert>
+
+#include <lfq_array_based.h>
+#include <lfq_spsc.h>
+
+using namespace std;
+
+// 模拟行情帧：较大的平凡类型，不可拷贝以确保全程没有元素拷贝
+struct Frame {
+    uint32_t producer;
+    uint32_t seq;
+    uint32_t checksum;
+    unsigned char body[1024];
+
+    Frame() = default;
+    Frame(const Frame&) = delete;
+    Frame& operator=(const Frame&) = delete;
+};
+
+void fill(Frame* f, uint32_t producer, uint32_t seq) {
+    f->producer = producer;
+    f->seq = seq;
+    memset(f->body, static_cast<int>(seq & 0xff), sizeof(f->body));
+    f->checksum = producer * 131u + seq;
+}
+
+bool verify(const Frame* f) {
+    if (f->checksum != f->producer * 131u + f->seq)
+        return false;
+    for (unsigned char b : f->body)
+        if (b != static_cast<unsigned char>(f->seq & 0xff))
+            return false;
+    return true;
+}
+
+// 采样时间戳排在元素之前、槽位带填充：commit 仍能由元素地址找到槽位
+struct stamped_traits : lfq_pow2_traits {
+    using slot_layout = lfq_padded_layout<128>;
+    using latency_policy = lfq_sampled_latency<1>;
+};
+
+// 基本语义：预留不可见、commit 后可见、release 归还槽位
+template <typename Queue>
+void test_basic(const char* name) {
+    cout << "===== Zero-Copy Basic Test: " << name << " =====" << endl;
+    Queue queue(4);
+    const size_t cap = queue.capacity();
+
+    Frame* f = queue.try_reserve();
+    assert(f != nullptr);
+    fill(f, 0, 1);
+    assert(queue.peek() == nullptr);  // 未 commit 前消费者看不到
+    queue.commit(f);
+
+    Frame* p = queue.peek();
+    assert(p == f && verify(p));       // 指向同一块队列内存
+    assert(queue.peek() == p);         // release 之前重复 peek 得到同一元素
+    queue.release();
+    assert(queue.peek() == nullptr);
+
+    // 填满后预留失败，release 一个后又能预留
+    for (size_t i = 0; i < cap; ++i) {
+        Frame* r = queue.try_reserve();
+        assert(r != nullptr);
+        fill(r, 0, static_cast<uint32_t>(i));
+        queue.commit(r);
+    }
+    assert(queue.try_reserve() == nullptr);
+    assert(queue.peek()->seq == 0);
+    queue.release();
+    Frame* r = queue.try_reserve();
+    assert(r != nullptr);
+    queue.commit(r);
+    for (size_t i = 1; i < cap; ++i) {
+        assert(queue.peek()->seq == i);
+        queue.release();
+    }
+    assert(queue.peek() == r);
+    queue.release();
+    assert(queue.empty());
+
+    // 带参数的预留与普通出队混用
+    lfq_array_based<string> strings(4);
+    string* s = strings.try_reserve(3, 'z');
+    assert(s != nullptr && *s == "zzz");
+    s->append("!");
+    strings.commit(s);
+    string out;
+    assert(strings.dequeue(out) && out == "zzz!");
+
+    cout << "Passed!\n" << endl;
+}
+
+// 多生产者乱序 commit：后预留的先提交时，消费者必须等前面的槽位
+void test_out_of_order_commit() {
+    cout << "===== Out-Of-Order Commit Test =====" << endl;
+    lfq_array_based<Frame, lfq_pow2_traits> queue(8);
+    Frame* a = queue.try_reserve();
+    Frame* b = queue.try_reserve();
+    assert(a && b && a != b);
+    fill(b, 0, 2);
+    queue.commit(b);
+    assert(queue.peek() == nullptr);  // a 尚未提交
+    fill(a, 0, 1);
+    queue.commit(a);
+    assert(queue.peek() == a && a->seq == 1);
+    queue.release();
+    assert(queue.peek() == b && b->seq == 2);
+    queue.release();
+    cout << "Passed!\n" << endl;
+}
+
+// 并发：多个生产者 try_reserve/commit，单消费者 peek/release
+void test_concurrent() {
+    cout << "===== Zero-Copy Concurrent Test =====" << endl;
+    lfq_array_based<Frame, lfq_pow2_traits> queue(64);
+    const int num_producers = 3;
+    const uint32_t per_producer = 5000;
+    atomic<bool> start{ false };
+
+    vector<thread> producers;
+    for (int i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            while (!start.load()) this_thread::yield();
+            for (uint32_t j = 0; j < per_producer; ++j) {
+                Frame* f;
+                while ((f = queue.try_reserve()) == nullptr)
+                    this_thread::yield();
+                fill(f, static_cast<uint32_t>(i), j);
+                queue.commit(f);
+            }
+            });
+    }
+
+    vector<uint32_t> next(num_producers, 0);
+    start.store(true);
+    for (uint32_t n = 0; n < num_producers * per_producer; ++n) {
+        Frame* f;
+        while ((f = queue.peek()) == nullptr)
+            this_thread::yield();
+        assert(verify(f));
+        assert(f->seq == next[f->producer]);  // 同一生产者内保持顺序
+        ++next[f->producer];
+        queue.release();
+    }
+    for (auto& p : producers) p.join();
+    assert(queue.empty());
+    cout << "Passed!\n" << endl;
+}
+
+// SPSC 版本的并发测试
+void test_spsc_concurrent() {
+    cout << "===== SPSC Zero-Copy Concurrent Test =====" << endl;
+    lfq_spsc<Frame> queue(32);
+    const uint32_t total = 20000;
+
+    thread producer([&] {
+        for (uint32_t j = 0; j < total; ++j) {
+            Frame* f;
+            while ((f = queue.try_reserve()) == nullptr)
+                this_thread::yield();
+            fill(f, 0, j);
+            queue.commit(f);
+        }
+        });
+
+    for (uint32_t n = 0; n < total; ++n) {
+        Frame* f;
+        while ((f = queue.peek()) == nullptr)
+            this_thread::yield();
+        assert(verify(f) && f->seq == n);
+        queue.release();
+    }
+    producer.join();
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_basic<lfq_array_based<Frame>>("array_based");
+    test_basic<lfq_array_based<Frame, lfq_pow2_traits>>("array_based pow2");
+    test_basic<lfq_array_based<Frame, stamped_traits>>("array_based sampled latency");
+    test_basic<lfq_spsc<Frame>>("spsc");
+    test_out_of_order_commit();
+    test_concurrent();
+    test_spsc_concurrent();
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
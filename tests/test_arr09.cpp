@@ -0,0 +1,156 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <cassert>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+using namespace std::chrono;
+
+struct yield_traits : lfq_pow2_traits {
+    using wait_strategy = lfq_spin_yield_wait<64>;
+};
+
+struct park_traits : lfq_pow2_traits {
+    using wait_strategy = lfq_park_wait<>;
+};
+
+struct park_mpmc_traits : lfq_mpmc_traits {
+    using wait_strategy = lfq_park_wait<>;
+};
+
+// 关闭后拒绝入队，剩余元素仍可取出，取空后 dequeue_wait 返回 false
+template <typename Traits>
+void test_close_semantics(const char* name) {
+    cout << "===== Close Semantics Test: " << name << " =====" << endl;
+    lfq_array_based<int, Traits> queue(8);
+    for (int i = 0; i < 3; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.is_closed());
+    queue.close();
+    assert(queue.is_closed());
+
+    int items[2] = { 10, 11 };
+    assert(!queue.enqueue(99));
+    assert(!queue.emplace(99));
+    assert(!queue.enqueue_bulk(items, 2));
+    assert(!queue.enqueue_wait(99, milliseconds(50)));
+    assert(!queue.enqueue_wait(99));  // 无超时版本也立即返回
+
+    int val;
+    assert(queue.dequeue(val) && val == 0);
+    assert(queue.dequeue_wait(val) && val == 1);
+    assert(queue.dequeue_wait(val, seconds(10)) && val == 2);
+
+    auto begin = steady_clock::now();
+    assert(!queue.dequeue_wait(val, seconds(10)));  // 已取空，不等超时
+    assert(!queue.dequeue_wait(val));
+    assert(steady_clock::now() - begin < seconds(5));
+    cout << "Passed!\n" << endl;
+}
+
+// 阻塞中的等待者被 close 唤醒
+template <typename Traits>
+void test_close_wakes_waiters(const char* name) {
+    cout << "===== Close Wakes Waiters Test: " << name << " =====" << endl;
+    lfq_array_based<int, Traits> empty_queue(4);
+    lfq_array_based<int, Traits> full_queue(2);
+    while (full_queue.enqueue(0)) {}
+
+    atomic<int> returned{ 0 };
+    thread consumer([&] {
+        int val;
+        assert(!empty_queue.dequeue_wait(val));
+        returned.fetch_add(1);
+        });
+    thread producer([&] {
+        assert(!full_queue.enqueue_wait(1));
+        returned.fetch_add(1);
+        });
+
+    this_thread::sleep_for(milliseconds(30));
+    assert(returned.load() == 0);
+    empty_queue.close();
+    full_queue.close();
+    consumer.join();
+    producer.join();
+    assert(returned.load() == 2);
+    cout << "Passed!\n" << endl;
+}
+
+// 关闭后未取走的元素由析构函数释放
+void test_close_destroys_remaining() {
+    cout << "===== Close Destroys Remaining Test =====" << endl;
+    auto tracker = make_shared<int>(0);
+    {
+        lfq_array_based<shared_ptr<int>> queue(8);
+        for (int i = 0; i < 5; ++i)
+            assert(queue.enqueue(tracker));
+        queue.close();
+        shared_ptr<int> out;
+        assert(queue.dequeue(out));
+        out.reset();
+        assert(tracker.use_count() == 5);
+    }
+    assert(tracker.use_count() == 1);
+    cout << "Passed!\n" << endl;
+}
+
+// 并发：生产者持续入队直到失败，消费者取到关闭且为空；入队成功的元素一个不少
+template <typename Traits>
+void test_concurrent_close(const char* name, size_t num_consumers) {
+    cout << "===== Concurrent Close Test: " << name << " =====" << endl;
+    lfq_array_based<int, Traits> queue(16);
+    const int num_producers = 3;
+
+    atomic<long long> produced_sum{ 0 };
+    atomic<long long> consumed_sum{ 0 };
+    vector<thread> threads;
+    for (int i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (int j = 1;; ++j) {
+                int item = i * 1000000 + j;
+                if (!queue.enqueue_wait(item))
+                    break;
+                produced_sum.fetch_add(item);
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&] {
+            int val;
+            while (queue.dequeue_wait(val))
+                consumed_sum.fetch_add(val);
+            });
+    }
+
+    this_thread::sleep_for(milliseconds(50));
+    queue.close();
+    for (auto& t : threads) t.join();
+
+    // 与 close 并发完成的入队可能在消费者退出后才发布
+    int val;
+    while (queue.dequeue(val))
+        consumed_sum.fetch_add(val);
+    assert(produced_sum.load() == consumed_sum.load());
+    assert(produced_sum.load() > 0);
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_close_semantics<lfq_default_traits>("default");
+    test_close_semantics<park_mpmc_traits>("park mpmc");
+    test_close_wakes_waiters<yield_traits>("spin-yield");
+    test_close_wakes_waiters<park_traits>("park");
+    test_close_destroys_remaining();
+    test_concurrent_close<yield_traits>("spin-yield mpsc", 1);
+    test_concurrent_close<park_traits>("park mpsc", 1);
+    test_concurrent_close<park_mpmc_traits>("park mpmc", 3);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
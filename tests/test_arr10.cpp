@@ -0,0 +1,163 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <cassert>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+struct stats_traits : lfq_pow2_traits {
+    using stats_policy = lfq_thread_stats;
+};
+
+struct stats_mpmc_traits : lfq_mpmc_traits {
+    using stats_policy = lfq_thread_stats;
+};
+
+// 单线程：各计数项与水位
+void test_counters() {
+    cout << "===== Stats Counters Test =====" << endl;
+    lfq_array_based<int, stats_traits> queue(4);
+
+    int val;
+    assert(!queue.dequeue(val));                 // empty
+    for (int i = 0; i < 4; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(4));                   // full
+    assert(!queue.enqueue(5));                   // full
+    for (int i = 0; i < 4; ++i)
+        assert(queue.dequeue(val));
+
+    // 已认领未提交：出队因 ready 未置位失败
+    int* reserved = queue.try_reserve(7);
+    assert(reserved != nullptr);
+    assert(!queue.dequeue(val));                 // not_ready
+    queue.commit(reserved);
+    assert(queue.dequeue(val) && val == 7);
+
+    int items[3] = { 1, 2, 3 };
+    assert(queue.enqueue_bulk(items, 3));
+    assert(queue.dequeue_bulk(items, 3) == 3);
+
+    lfq_stats_snapshot s = queue.stats();
+    assert(s[lfq_stat::enqueued] == 8);
+    assert(s[lfq_stat::dequeued] == 8);
+    assert(s[lfq_stat::full] == 2);
+    assert(s[lfq_stat::empty] == 1);
+    assert(s[lfq_stat::not_ready] == 1);
+    assert(s[lfq_stat::cas_retry] == 0);
+    assert(s[lfq_stat::slot_busy] == 0);
+    assert(s.high_water == 4);
+    assert(s.threads == 1);
+
+    // 默认配置不统计
+    lfq_array_based<int> plain(4);
+    assert(plain.enqueue(1) && plain.dequeue(val));
+    assert(plain.stats()[lfq_stat::enqueued] == 0 && plain.stats().threads == 0);
+
+    cout << "Passed!\n" << endl;
+}
+
+// 同一线程先后使用大量短命的队列，以及同时交替使用超过线程局部表长度的队列
+void test_many_queues() {
+    cout << "===== Stats Many Queues Test =====" << endl;
+    int val;
+    for (int round = 0; round < 20000; ++round) {
+        lfq_array_based<int, stats_traits> queue(4);
+        assert(queue.enqueue(round) && queue.dequeue(val) && val == round);
+        assert(!queue.dequeue(val));
+        lfq_stats_snapshot s = queue.stats();
+        assert(s[lfq_stat::enqueued] == 1 && s[lfq_stat::dequeued] == 1 && s[lfq_stat::empty] == 1);
+        assert(s.threads == 1);
+    }
+
+    // 300 个队列同时存活，逐个轮流操作：有的命中线程局部表，多出的走慢路径，计数都不串
+    vector<unique_ptr<lfq_array_based<int, stats_traits>>> queues;
+    for (int i = 0; i < 300; ++i)
+        queues.emplace_back(new lfq_array_based<int, stats_traits>(8));
+    for (int pass = 0; pass < 5; ++pass) {
+        for (size_t i = 0; i < queues.size(); ++i) {
+            for (size_t k = 0; k <= i % 3; ++k)
+                assert(queues[i]->enqueue(static_cast<int>(i)));
+        }
+        for (auto& q : queues)
+            while (q->dequeue(val)) {}
+    }
+    for (size_t i = 0; i < queues.size(); ++i) {
+        lfq_stats_snapshot s = queues[i]->stats();
+        assert(s[lfq_stat::enqueued] == 5 * (i % 3 + 1));
+        assert(s[lfq_stat::dequeued] == 5 * (i % 3 + 1));
+        assert(s[lfq_stat::empty] == 5);
+        assert(s.threads == 1);
+    }
+
+    // 释放一半后新建的队列复用下标，不会读到旧队列的计数块
+    queues.resize(150);
+    for (int i = 0; i < 150; ++i)
+        queues.emplace_back(new lfq_array_based<int, stats_traits>(8));
+    for (size_t i = 150; i < queues.size(); ++i) {
+        assert(queues[i]->stats().threads == 0);
+        assert(queues[i]->enqueue(1));
+        assert(queues[i]->stats()[lfq_stat::enqueued] == 1);
+    }
+
+    cout << "Passed!\n" << endl;
+}
+
+// 多线程：各线程独立计数，汇总后与实际操作数一致
+template <typename Traits>
+void test_concurrent(const char* name, size_t num_consumers) {
+    cout << "===== Stats Concurrent Test: " << name << " =====" << endl;
+    const size_t num_producers = 3;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_based<int, Traits> queue(64);
+
+    atomic<size_t> consumed{ 0 };
+    vector<thread> threads;
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < items_per_producer; ++j)
+                while (!queue.enqueue(static_cast<int>(j)))
+                    this_thread::yield();
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&] {
+            int val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val))
+                    consumed.fetch_add(1, memory_order_relaxed);
+                else
+                    this_thread::yield();
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    lfq_stats_snapshot s = queue.stats();
+    assert(s[lfq_stat::enqueued] == total);
+    assert(s[lfq_stat::dequeued] == total);
+    assert(s.high_water >= 1 && s.high_water <= queue.capacity());
+    assert(s.threads == num_producers + num_consumers);
+    cout << "cas_retry=" << s[lfq_stat::cas_retry]
+        << " full=" << s[lfq_stat::full]
+        << " slot_busy=" << s[lfq_stat::slot_busy]
+        << " empty=" << s[lfq_stat::empty]
+        << " not_ready=" << s[lfq_stat::not_ready]
+        << " high_water=" << s.high_water << endl;
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_counters();
+    test_many_queues();
+    test_concurrent<stats_traits>("mpsc", 1);
+    test_concurrent<stats_mpmc_traits>("mpmc", 2);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
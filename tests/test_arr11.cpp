@@ -0,0 +1,157 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cassert>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+using namespace std::chrono;
+
+struct every_traits : lfq_pow2_traits {
+    using latency_policy = lfq_sampled_latency<1>;
+};
+
+struct sampled_traits : lfq_pow2_traits {
+    using latency_policy = lfq_sampled_latency<4>;
+};
+
+struct sampled_mpmc_traits : lfq_mpmc_traits {
+    using latency_policy = lfq_sampled_latency<8, lfq_tsc_clock>;
+};
+
+// 分桶：小值精确，大值相对误差不超过 1/16，桶上界单调递增
+void test_histogram_buckets() {
+    cout << "===== Histogram Bucket Test =====" << endl;
+    using H = lfq_latency_histogram;
+    for (uint64_t v = 0; v < 16; ++v)
+        assert(H::bucket_of(v) == v && H::bucket_upper(v) == v);
+
+    uint64_t const samples[] = { 16, 17, 31, 32, 33, 100, 1000, 123456, 1ull << 40, ~0ull };
+    for (uint64_t v : samples) {
+        size_t const b = H::bucket_of(v);
+        uint64_t const upper = H::bucket_upper(b);
+        assert(b < H::bucket_count);
+        assert(upper >= v);
+        assert(upper - v <= v / 16);
+        if (b > 0)
+            assert(H::bucket_upper(b - 1) < v);
+    }
+    for (size_t b = 1; b < H::bucket_count; ++b)
+        assert(H::bucket_upper(b) > H::bucket_upper(b - 1));
+
+    lfq_sampled_latency<1> lat;
+    assert(lat.snapshot().total == 0 && lat.snapshot().percentile(0.99) == 0);
+    cout << "Passed!\n" << endl;
+}
+
+// 驻留时间：元素在队列中停留约 5ms
+void test_residency() {
+    cout << "===== Residency Test =====" << endl;
+    lfq_array_based<int, every_traits> queue(16);
+    for (int i = 0; i < 10; ++i)
+        assert(queue.enqueue(i));
+    this_thread::sleep_for(milliseconds(5));
+    int val;
+    for (int i = 0; i < 10; ++i)
+        assert(queue.dequeue(val));
+
+    lfq_latency_snapshot s = queue.latency();
+    assert(s.total == 10);
+    assert(s.percentile(0.5) >= 5000000);  // 纳秒
+    assert(s.max() < 5000000000ull);
+
+    // 默认配置不采样
+    lfq_array_based<int> plain(16);
+    assert(plain.enqueue(1) && plain.dequeue(val));
+    assert(plain.latency().total == 0);
+    cout << "Passed!\n" << endl;
+}
+
+// 采样间隔：只有序号为间隔整数倍的元素被记录，各种出队方式都计入
+void test_sampling() {
+    cout << "===== Sampling Test =====" << endl;
+    lfq_array_based<int, sampled_traits> queue(64);
+    int items[32];
+    for (int i = 0; i < 32; ++i)
+        items[i] = i;
+
+    assert(queue.enqueue_bulk(items, 32));    // 序号 0..31
+    for (int i = 0; i < 16; ++i) {
+        int* p = queue.try_reserve(i);        // 序号 32..47
+        queue.commit(p);
+    }
+    assert(queue.dequeue_bulk(items, 32) == 32);
+    for (int i = 0; i < 8; ++i) {
+        int val;
+        assert(queue.dequeue(val));
+    }
+    for (int i = 0; i < 8; ++i) {
+        assert(queue.peek() != nullptr);
+        queue.release();
+    }
+    assert(queue.latency().total == 48 / 4);
+    cout << "Passed!\n" << endl;
+}
+
+// 并发：多消费者同时记录，另一个线程同时读取
+void test_concurrent() {
+    cout << "===== Concurrent Latency Test =====" << endl;
+    const size_t num_producers = 2;
+    const size_t num_consumers = 2;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_based<int, sampled_mpmc_traits> queue(64);
+
+    atomic<size_t> consumed{ 0 };
+    atomic<bool> done{ false };
+    vector<thread> threads;
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&] {
+            for (size_t j = 0; j < items_per_producer; ++j)
+                while (!queue.enqueue(static_cast<int>(j)))
+                    this_thread::yield();
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&] {
+            int val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val))
+                    consumed.fetch_add(1, memory_order_relaxed);
+                else
+                    this_thread::yield();
+            }
+            });
+    }
+    thread monitor([&] {
+        uint64_t last = 0;
+        while (!done.load()) {
+            uint64_t const n = queue.latency().total;
+            assert(n >= last);
+            last = n;
+            this_thread::sleep_for(milliseconds(1));
+        }
+        });
+    for (auto& t : threads) t.join();
+    done.store(true);
+    monitor.join();
+
+    lfq_latency_snapshot s = queue.latency();
+    assert(s.total == total / 8);
+    assert(s.percentile(0.5) <= s.percentile(0.99) && s.percentile(0.99) <= s.max());
+    cout << "p50=" << s.percentile(0.5) << " p99=" << s.percentile(0.99) << " (TSC cycles)" << endl;
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_histogram_buckets();
+    test_residency();
+    test_sampling();
+    test_concurrent();
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
@@ -0,0 +1,179 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <cstdint>
+#include <cstring>
+#include <fstream>
+#include <string>
+#include <stdexcept>
+#include <system_error>
+#include <cassert>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+// 记录分配/释放的分配器，验证队列按相同的大小与对齐归还缓冲区
+struct counting_allocator {
+    static int live;
+    static size_t last_bytes;
+
+    void* allocate(size_t bytes, size_t align) {
+        ++live;
+        last_bytes = bytes;
+        assert(align >= 1 && (align & (align - 1)) == 0);
+        return lfq_new_allocator().allocate(bytes, align);
+    }
+
+    void deallocate(void* p, size_t bytes, size_t align) noexcept {
+        --live;
+        assert(bytes == last_bytes);
+        lfq_new_allocator().deallocate(p, bytes, align);
+    }
+};
+int counting_allocator::live = 0;
+size_t counting_allocator::last_bytes = 0;
+
+struct counting_traits : lfq_pow2_traits {
+    using allocator = counting_allocator;
+};
+
+struct huge_traits : lfq_pow2_traits {
+    using allocator = lfq_hugepage_allocator;
+};
+
+struct huge_mpmc_traits : lfq_mpmc_traits {
+    using allocator = lfq_hugepage_allocator;
+};
+
+// 分配器的调用与配对
+void test_allocator_pairing() {
+    cout << "===== Allocator Pairing Test =====" << endl;
+    {
+        lfq_array_based<int, counting_traits> queue(1000);
+        assert(counting_allocator::live == 1);
+        assert(counting_allocator::last_bytes >= 1024 * sizeof(int));
+        assert(queue.enqueue(1));
+    }
+    assert(counting_allocator::live == 0);
+
+    // 容量为0时在分配前抛出异常
+    bool thrown = false;
+    try {
+        lfq_array_based<int, counting_traits> bad(0);
+    }
+    catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+    assert(counting_allocator::live == 0);
+    cout << "Passed!\n" << endl;
+}
+
+// 大页分配器：2MB 对齐、可读写、按节点绑定（绑定失败时抛出）
+void test_hugepage_allocator() {
+    cout << "===== Hugepage Allocator Test =====" << endl;
+    lfq_hugepage_allocator alloc;
+    alloc.numa_node = lfq_current_numa_node();
+    cout << "numa node: " << alloc.numa_node << endl;
+
+    size_t const bytes = 3 * 1024 * 1024 + 123;
+    void* p = alloc.allocate(bytes, 64);
+    assert(p != nullptr);
+#if defined(__linux__)
+    assert(reinterpret_cast<uintptr_t>(p) % lfq_hugepage_allocator::huge_page_size == 0);
+#endif
+    memset(p, 0x5a, bytes);
+    assert(static_cast<unsigned char*>(p)[bytes - 1] == 0x5a);
+    alloc.deallocate(p, bytes, 64);
+
+    // 不预先缺页、尝试预留大页（系统未配置时退回透明大页）
+    alloc.prefault = false;
+    alloc.use_hugetlb = true;
+    p = alloc.allocate(4096, 64);
+    static_cast<unsigned char*>(p)[0] = 1;
+    alloc.deallocate(p, 4096, 64);
+
+    // 节点编号超出 mbind 掩码时在映射前拒绝
+    alloc.numa_node = lfq_hugepage_allocator::max_numa_node;
+    bool thrown = false;
+    try {
+        alloc.allocate(4096, 64);
+    }
+    catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 编号在范围内但节点不存在：mbind 失败时抛出，不退回首次访问分配
+    int missing = 0;
+    while (missing < lfq_hugepage_allocator::max_numa_node &&
+        ifstream("/sys/devices/system/node/node" + to_string(missing) + "/meminfo"))
+        ++missing;
+    if (missing > 0 && missing < lfq_hugepage_allocator::max_numa_node) {
+        alloc.numa_node = missing;
+        thrown = false;
+        try {
+            alloc.allocate(4096, 64);
+        }
+        catch (const system_error& e) {
+            cout << "node " << missing << ": " << e.what() << endl;
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    cout << "Passed!\n" << endl;
+}
+
+// 使用大页缓冲区的队列（构造时传入配置好的分配器）
+void test_hugepage_queue() {
+    cout << "===== Hugepage Queue Test =====" << endl;
+    lfq_hugepage_allocator alloc;
+    alloc.numa_node = lfq_current_numa_node();
+    lfq_array_based<uint64_t, huge_mpmc_traits> queue(1 << 16, alloc);
+
+    const size_t num_producers = 2;
+    const size_t items_per_producer = 50000;
+    const size_t total = num_producers * items_per_producer;
+    atomic<size_t> consumed{ 0 };
+    atomic<uint64_t> sum{ 0 };
+    vector<thread> threads;
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&] {
+            for (uint64_t j = 1; j <= items_per_producer; ++j)
+                while (!queue.enqueue(j))
+                    this_thread::yield();
+            });
+    }
+    for (int c = 0; c < 2; ++c) {
+        threads.emplace_back([&] {
+            uint64_t val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val)) {
+                    sum.fetch_add(val, memory_order_relaxed);
+                    consumed.fetch_add(1, memory_order_relaxed);
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+    assert(sum.load() == num_producers * items_per_producer * (items_per_producer + 1) / 2);
+
+    // 默认构造的分配器
+    lfq_array_based<int, huge_traits> small(8);
+    assert(small.enqueue(1));
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_allocator_pairing();
+    test_hugepage_allocator();
+    test_hugepage_queue();
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
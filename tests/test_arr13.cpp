@@ -0,0 +1,203 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <cassert>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+// 单消费者每取4个发布一次 head
+struct batch_traits : lfq_pow2_traits {
+    static constexpr size_t head_publish_interval = 4;
+};
+
+// 并发测试用的较大间隔
+struct batch32_traits : lfq_pow2_traits {
+    static constexpr size_t head_publish_interval = 32;
+};
+
+// 攒满间隔或追上可见的 tail 时才发布，之前生产者仍按旧的 head 判断空间
+void test_deferred_publish() {
+    cout << "===== Deferred Publish Test =====" << endl;
+    lfq_array_based<int, batch_traits> queue(8);
+
+    int val;
+    for (int i = 0; i < 3; ++i)
+        assert(queue.enqueue(i));
+    assert(queue.dequeue(val) && val == 0);
+    assert(queue.dequeue(val) && val == 1);  // 未攒满4个，也未追上 tail=3
+
+    // 生产者看到的 head 仍为0：只能再放5个
+    for (int i = 3; i < 8; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(8));
+
+    // 取到缓存的 tail=3 时发布，腾出3个位置
+    assert(queue.dequeue(val) && val == 2);
+    for (int i = 8; i < 11; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(11));
+
+    // 取满4个时发布
+    for (int i = 3; i < 7; ++i)
+        assert(queue.dequeue(val) && val == i);
+    for (int i = 11; i < 15; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(15));
+
+    // 取空后 head 已发布，判空准确
+    for (int i = 7; i < 15; ++i)
+        assert(queue.dequeue(val) && val == i);
+    assert(queue.empty());
+    assert(!queue.dequeue(val));
+
+    cout << "Deferred publish tests passed!\n" << endl;
+}
+
+// 出队失败（元素未写完）时发布已取走的进度
+void test_idle_publish() {
+    cout << "===== Idle Publish Test =====" << endl;
+    lfq_array_based<int, batch_traits> queue(4);
+
+    int val;
+    assert(queue.enqueue(0) && queue.enqueue(1));
+    int* reserved = queue.try_reserve(2);
+    assert(reserved != nullptr);
+    assert(queue.enqueue(3));
+    assert(!queue.enqueue(4));
+
+    assert(queue.dequeue(val) && val == 0);
+    assert(queue.dequeue(val) && val == 1);
+    assert(!queue.enqueue(4));  // 尚未发布
+
+    assert(!queue.dequeue(val));  // 序号2未提交：出队失败并发布
+    assert(queue.enqueue(4) && queue.enqueue(5));
+    assert(!queue.enqueue(6));
+
+    queue.commit(reserved);
+    for (int i = 2; i < 6; ++i)
+        assert(queue.dequeue(val) && val == i);
+    assert(queue.empty());
+
+    cout << "Idle publish tests passed!\n" << endl;
+}
+
+// 批量出队与 peek/release 共用消费者私有的 head
+void test_bulk_and_peek() {
+    cout << "===== Bulk And Peek Test =====" << endl;
+    lfq_array_based<int, batch_traits> queue(16);
+
+    int items[16];
+    for (int i = 0; i < 16; ++i)
+        items[i] = i;
+    assert(queue.enqueue_bulk(items, 16));
+
+    int out[16];
+    assert(queue.dequeue_bulk(out, 2) == 2);
+    assert(out[0] == 0 && out[1] == 1);
+    assert(!queue.enqueue(16));  // 2个未发布
+
+    int* p = queue.peek();
+    assert(p != nullptr && *p == 2);
+    queue.release();
+    p = queue.peek();
+    assert(p != nullptr && *p == 3);
+    queue.release();  // 攒满4个，发布
+    assert(queue.enqueue(16) && queue.enqueue(17) && queue.enqueue(18) && queue.enqueue(19));
+    assert(!queue.enqueue(20));
+
+    int val;
+    assert(queue.dequeue(val) && val == 4);
+    assert(queue.dequeue_bulk(out, 16) == 15);
+    for (int i = 0; i < 15; ++i)
+        assert(out[i] == 5 + i);
+    assert(queue.peek() == nullptr);
+    assert(queue.empty());
+
+    cout << "Bulk and peek tests passed!\n" << endl;
+}
+
+// 关闭后 dequeue_wait 取完剩余元素即返回 false，不会卡在未发布的 head 上
+void test_close_drain() {
+    cout << "===== Close Drain Test =====" << endl;
+    lfq_array_based<int, batch32_traits> queue(64);
+    for (int i = 0; i < 10; ++i)
+        assert(queue.enqueue(i));
+    queue.close();
+
+    int val;
+    for (int i = 0; i < 10; ++i)
+        assert(queue.dequeue_wait(val, chrono::milliseconds(100)) && val == i);
+    assert(!queue.dequeue_wait(val));
+
+    cout << "Close drain tests passed!\n" << endl;
+}
+
+// 多生产者单消费者：批量发布下不丢失、不重复，逐生产者 FIFO
+template <typename Traits>
+void test_concurrent(const char* name, size_t capacity) {
+    cout << "===== Concurrent Test: " << name << " (capacity " << capacity << ") =====" << endl;
+    const size_t num_producers = 3;
+    const size_t items_per_producer = 50000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_based<int, Traits> queue(capacity);
+
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                int item = static_cast<int>(i * items_per_producer + j);
+                while (!queue.enqueue(item))
+                    this_thread::yield();
+            }
+            });
+    }
+
+    vector<int> last(num_producers, -1);
+    vector<bool> seen(total, false);
+    size_t received = 0;
+    int buf[8];
+    while (received < total) {
+        // 交替使用单个与批量出队
+        size_t n = 0;
+        if (received % 3 == 0) {
+            n = queue.dequeue_bulk(buf, 8);
+        }
+        else if (queue.dequeue(buf[0])) {
+            n = 1;
+        }
+        if (n == 0) {
+            this_thread::yield();
+            continue;
+        }
+        for (size_t k = 0; k < n; ++k) {
+            int item = buf[k];
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+        received += n;
+    }
+    for (auto& t : producers) t.join();
+    assert(queue.empty());
+
+    cout << "Concurrent test passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_deferred_publish();
+    test_idle_publish();
+    test_bulk_and_peek();
+    test_close_drain();
+    test_concurrent<batch32_traits>("interval 32", 256);
+    test_concurrent<batch32_traits>("interval 32", 16);  // 间隔大于容量时追上 tail 才发布
+    test_concurrent<batch_traits>("interval 4", 4);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
@@ -0,0 +1,191 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <algorithm>
+#include <cassert>
+
+#include <lfq_array_based.h>
+
+using namespace std;
+
+struct exp_traits : lfq_pow2_traits {
+    using backoff_policy = lfq_exp_backoff<1, 64>;
+    using stats_policy = lfq_thread_stats;
+};
+
+struct adaptive_traits : lfq_pow2_traits {
+    using backoff_policy = lfq_adaptive_backoff<6>;
+    using stats_policy = lfq_thread_stats;
+};
+
+struct adaptive_mpmc_traits : lfq_mpmc_traits {
+    using backoff_policy = lfq_adaptive_backoff<6>;
+    using stats_policy = lfq_thread_stats;
+};
+
+// 指数退避：等待时间逐次翻倍，超过上限后让出时间片
+void test_exp_policy() {
+    cout << "===== Exponential Backoff Policy Test =====" << endl;
+    lfq_exp_backoff<1, 4> backoff;
+    assert(!backoff.retry());  // 1
+    assert(!backoff.retry());  // 2
+    assert(!backoff.retry());  // 4
+    assert(backoff.retry());   // 超过上限
+    assert(backoff.retry());
+
+    // 每次操作重新开始
+    lfq_exp_backoff<1, 4> next;
+    assert(!next.retry());
+
+    cout << "Passed!\n" << endl;
+}
+
+// 自适应退避：级别按线程、按队列保存，失败时升高，没有失败的操作使其回落
+void test_adaptive_policy() {
+    cout << "===== Adaptive Backoff Policy Test =====" << endl;
+    thread([] {
+        using policy = lfq_adaptive_backoff<3>;
+        policy::state st;
+        assert(policy::level(st) == 0);
+
+        {
+            policy op(st);
+            assert(!op.retry() && !op.retry() && !op.retry());
+            assert(policy::level(st) == 3);
+            assert(op.retry());  // 达到上限后让出时间片
+            op.success();
+            assert(policy::level(st) == 3);  // 失败过的操作不降级
+        }
+
+        // 下一次操作第一次重试即让出时间片
+        {
+            policy op(st);
+            assert(op.retry());
+        }
+
+        // 另一个队列的级别互不影响
+        {
+            policy::state other;
+            assert(policy::level(other) == 0);
+            policy op(other);
+            assert(!op.retry());
+            assert(policy::level(other) == 1);
+            assert(policy::level(st) == 3);
+        }
+
+        // 连续无失败的操作逐级回落
+        for (unsigned expect = 2;; --expect) {
+            policy op(st);
+            op.success();
+            assert(policy::level(st) == expect);
+            if (expect == 0)
+                break;
+        }
+        {
+            policy op(st);
+            op.success();
+            assert(policy::level(st) == 0);
+        }
+
+        // 其他线程的级别互不影响
+        {
+            policy op(st);
+            op.retry();
+        }
+        thread([&st] { assert(policy::level(st) == 0); }).join();
+        assert(policy::level(st) == 1);
+
+        // 新队列复用已析构队列的表项时从0开始
+        {
+            policy::state a;
+            policy op(a);
+            op.retry();
+            op.retry();
+            assert(policy::level(a) == 2);
+        }
+        policy::state b;
+        assert(policy::level(b) == 0);
+        }).join();
+
+    cout << "Passed!\n" << endl;
+}
+
+// 多生产者争抢 tail：退避不影响正确性，重试与让出时间片计入统计
+template <typename Traits>
+void test_contended(const char* name, size_t num_producers, size_t num_consumers) {
+    cout << "===== Contended Test: " << name << " (" << num_producers << "P/" << num_consumers << "C) =====" << endl;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_based<int, Traits> queue(256);
+
+    atomic<size_t> consumed{ 0 };
+    vector<vector<int>> received(num_consumers);
+    vector<thread> threads;
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; j += 4) {
+                int const base = static_cast<int>(i * items_per_producer + j);
+                // 单个与批量入队交替，两条 CAS 路径都经过退避
+                if (j % 8 == 0) {
+                    int items[4] = { base, base + 1, base + 2, base + 3 };
+                    while (!queue.enqueue_bulk(items, 4))
+                        this_thread::yield();
+                }
+                else {
+                    for (int k = 0; k < 4; ++k)
+                        while (!queue.enqueue(base + k))
+                            this_thread::yield();
+                }
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            int buf[4];
+            while (consumed.load(memory_order_relaxed) < total) {
+                size_t n = queue.dequeue_bulk(buf, c % 2 ? 4 : 1);
+                if (n == 0) {
+                    this_thread::yield();
+                    continue;
+                }
+                received[c].insert(received[c].end(), buf, buf + n);
+                consumed.fetch_add(n, memory_order_relaxed);
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    vector<bool> seen(total, false);
+    for (auto& items : received) {
+        vector<int> last(num_producers, -1);
+        for (int item : items) {
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+    }
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+    assert(queue.empty());
+
+    lfq_stats_snapshot s = queue.stats();
+    assert(s[lfq_stat::enqueued] == total);
+    assert(s[lfq_stat::dequeued] == total);
+    assert(s[lfq_stat::backoff_yield] <= s[lfq_stat::cas_retry]);
+    cout << "cas_retry=" << s[lfq_stat::cas_retry]
+        << " backoff_yield=" << s[lfq_stat::backoff_yield] << endl;
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_exp_policy();
+    test_adaptive_policy();
+    test_contended<exp_traits>("exp", 8, 1);
+    test_contended<adaptive_traits>("adaptive", 8, 1);
+    test_contended<adaptive_mpmc_traits>("adaptive mpmc", 4, 4);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
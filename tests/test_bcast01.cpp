@@ -0,0 +1,232 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <cassert>
+
+#include <lfq_broadcast.h>
+
+using namespace std;
+
+// 每个消费者都读到全部元素，各自独立前进
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    lfq_broadcast<int> ring(3);  // 取整为4
+    assert(ring.capacity() == 4);
+    size_t const a = ring.add_consumer();
+    size_t const b = ring.add_consumer();
+    assert(ring.consumers() == 2);
+    assert(ring.empty(a) && ring.empty(b));
+
+    int val;
+    assert(!ring.dequeue(a, val));
+    for (int i = 0; i < 4; ++i)
+        assert(ring.enqueue(i));
+    assert(!ring.enqueue(4));  // 两个消费者都没读，已满
+
+    // a 读完，b 未读：仍受 b 门控
+    for (int i = 0; i < 4; ++i)
+        assert(ring.dequeue(a, val) && val == i);
+    assert(ring.empty(a));
+    assert(!ring.empty(b));
+    assert(!ring.enqueue(4));
+
+    // b 批量读取两个后腾出两个位置
+    vector<int> seen;
+    assert(ring.consume(b, [&](const int& v) { seen.push_back(v); }, 2) == 2);
+    assert(seen == vector<int>({ 0, 1 }));
+    assert(ring.enqueue(4) && ring.emplace(5));
+    assert(!ring.enqueue(6));
+
+    seen.clear();
+    assert(ring.consume(b, [&](const int& v) { seen.push_back(v); }) == 4);
+    assert(seen == vector<int>({ 2, 3, 4, 5 }));
+    assert(ring.dequeue(a, val) && val == 4);
+    assert(ring.dequeue(a, val) && val == 5);
+    assert(!ring.dequeue(a, val) && !ring.dequeue(b, val));
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+// 注册规则
+void test_registration() {
+    cout << "===== Registration Test =====" << endl;
+    bool thrown = false;
+    try {
+        lfq_broadcast<int> bad(0);
+    }
+    catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    lfq_broadcast<int> ring(4);
+    thrown = false;
+    try {
+        ring.add_consumer({ 0 });  // 依赖尚未注册的消费者
+    }
+    catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 没有消费者时入队总是成功，旧元素被覆盖
+    for (int i = 0; i < 10; ++i)
+        assert(ring.enqueue(i));
+
+    thrown = false;
+    try {
+        ring.add_consumer();  // 已开始入队
+    }
+    catch (const logic_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "Registration tests passed!\n" << endl;
+}
+
+// 依赖屏障：下游只能读到上游已处理完的元素，门控只看末端消费者
+void test_dependency_barrier() {
+    cout << "===== Dependency Barrier Test =====" << endl;
+    lfq_broadcast<int> ring(4);
+    size_t const journal = ring.add_consumer();
+    size_t const replicate = ring.add_consumer();
+    size_t const logic = ring.add_consumer({ journal, replicate });
+
+    for (int i = 0; i < 4; ++i)
+        assert(ring.enqueue(i));
+
+    int val;
+    assert(ring.empty(logic));  // 上游都未处理
+    assert(ring.dequeue(journal, val) && val == 0);
+    assert(ring.dequeue(journal, val) && val == 1);
+    assert(ring.empty(logic));  // replicate 尚未处理
+    assert(ring.dequeue(replicate, val) && val == 0);
+
+    vector<int> seen;
+    assert(ring.consume(logic, [&](const int& v) { seen.push_back(v); }) == 1);
+    assert(seen == vector<int>({ 0 }));
+    assert(ring.empty(logic));
+
+    // 上游都读完，门控仍由末端的 logic 决定
+    while (ring.dequeue(journal, val)) {}
+    while (ring.dequeue(replicate, val)) {}
+    assert(ring.enqueue(4));
+    assert(!ring.enqueue(5));
+
+    seen.clear();
+    assert(ring.consume(logic, [&](const int& v) { seen.push_back(v); }) == 3);
+    assert(seen == vector<int>({ 1, 2, 3 }));
+    assert(ring.empty(logic));  // 4 尚未被上游处理
+    assert(ring.enqueue(5));
+
+    cout << "Dependency barrier tests passed!\n" << endl;
+}
+
+// 统计拷贝次数的元素
+struct counted {
+    static int copies;
+    shared_ptr<int> payload;
+    explicit counted(shared_ptr<int> p) : payload(std::move(p)) {}
+    counted(const counted& other) : payload(other.payload) { ++copies; }
+    counted(counted&&) = default;
+    counted& operator=(const counted& other) { payload = other.payload; ++copies; return *this; }
+    counted& operator=(counted&&) = default;
+};
+
+int counted::copies = 0;
+
+// 只写一次：消费者读取不拷贝；元素在被覆盖或队列析构时释放
+void test_single_write() {
+    cout << "===== Single Write Test =====" << endl;
+    auto tracker = make_shared<int>(7);
+    {
+        lfq_broadcast<counted> ring(2);
+        size_t const a = ring.add_consumer();
+        size_t const b = ring.add_consumer();
+        size_t const c = ring.add_consumer();
+
+        assert(ring.emplace(tracker));
+        assert(ring.enqueue(counted(tracker)));
+        assert(tracker.use_count() == 3);
+
+        for (size_t id : { a, b, c }) {
+            assert(ring.consume(id, [&](const counted& v) { assert(*v.payload == 7); }) == 2);
+        }
+        assert(counted::copies == 0);
+
+        // 覆盖时析构上一圈的元素
+        assert(ring.enqueue(counted(make_shared<int>(1))));
+        assert(tracker.use_count() == 2);
+    }
+    assert(tracker.use_count() == 1);
+
+    cout << "Single write tests passed!\n" << endl;
+}
+
+// 并发：多个生产者，两个独立消费者 + 一个依赖二者的下游消费者
+void test_concurrent() {
+    cout << "===== Concurrent Test =====" << endl;
+    constexpr int PRODUCERS = 3;
+    constexpr int ITEMS = 20000;
+    constexpr int TOTAL = PRODUCERS * ITEMS;
+    lfq_broadcast<int> ring(64);
+    size_t const a = ring.add_consumer();
+    size_t const b = ring.add_consumer();
+    size_t const c = ring.add_consumer({ a, b });
+
+    // 上游处理过的元素打上标记，下游读取时必须已有两个标记
+    vector<atomic<int>> marks(TOTAL);
+    for (auto& m : marks) m.store(0);
+
+    vector<thread> threads;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        threads.emplace_back([&ring, p] {
+            for (int i = 0; i < ITEMS; ++i) {
+                while (!ring.enqueue(p * ITEMS + i))
+                    this_thread::yield();
+            }
+        });
+    }
+
+    auto run_consumer = [&](size_t id, bool downstream) {
+        vector<int> next(PRODUCERS, 0);
+        int received = 0;
+        while (received < TOTAL) {
+            size_t const n = ring.consume(id, [&](const int& v) {
+                int const p = v / ITEMS;
+                assert(v % ITEMS == next[p]);  // 逐生产者 FIFO
+                ++next[p];
+                if (downstream)
+                    assert(marks[v].load(memory_order_relaxed) == 2);
+                else
+                    marks[v].fetch_add(1, memory_order_relaxed);
+            }, 16);
+            if (n == 0)
+                this_thread::yield();
+            received += static_cast<int>(n);
+        }
+        assert(ring.empty(id));
+    };
+    threads.emplace_back(run_consumer, a, false);
+    threads.emplace_back(run_consumer, b, false);
+    threads.emplace_back(run_consumer, c, true);
+
+    for (auto& t : threads) t.join();
+
+    cout << "Concurrent tests passed!\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_registration();
+    test_dependency_barrier();
+    test_single_write();
+    test_concurrent();
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
@@ -0,0 +1,245 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <memory>
+#include <string>
+#include <stdexcept>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_array_faa.h>
+
+using namespace std;
+
+// 单线程基本功能
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    lfq_array_faa<int> queue(5);  // 取整为8，全部可用
+    assert(queue.capacity() == 8);
+    assert(queue.empty());
+
+    // 队列操作放在 assert 之外，NDEBUG 下照常执行
+    int val;
+    bool ok = queue.dequeue(val);
+    assert(!ok);
+    for (int i = 0; i < 8; ++i) {
+        ok = queue.enqueue(i);
+        assert(ok);
+    }
+    ok = queue.enqueue(8);
+    assert(!ok);
+    assert(!queue.empty());
+
+    for (int i = 0; i < 8; ++i) {
+        ok = queue.dequeue(val);
+        assert(ok && val == i);
+    }
+    assert(queue.empty());
+    ok = queue.dequeue(val);
+    assert(!ok);
+
+    // 多圈回绕
+    for (int round = 0; round < 100; ++round) {
+        ok = queue.emplace(round) && queue.enqueue(round + 1000);
+        assert(ok);
+        ok = queue.dequeue(val);
+        assert(ok && val == round);
+        ok = queue.dequeue(val);
+        assert(ok && val == round + 1000);
+    }
+    ok = queue.dequeue(val);
+    assert(!ok);
+
+    bool thrown = false;
+    try {
+        lfq_array_faa<int> bad(0);
+    }
+    catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+// 非平凡类型：出队后析构，队列析构时释放剩余元素
+void test_element_lifetime() {
+    cout << "===== Element Lifetime Test =====" << endl;
+    auto tracker = make_shared<int>(0);
+    {
+        lfq_array_faa<shared_ptr<int>> queue(4);
+        bool ok = true;
+        for (int i = 0; i < 4; ++i)
+            ok = queue.enqueue(tracker) && ok;
+        assert(ok);
+        assert(tracker.use_count() == 5);
+
+        shared_ptr<int> out;
+        ok = queue.dequeue(out);
+        assert(ok);
+        out.reset();
+        assert(tracker.use_count() == 4);
+
+        ok = queue.emplace(tracker);
+        assert(ok);
+        ok = queue.enqueue(make_shared<int>(1));
+        assert(!ok);
+    }
+    assert(tracker.use_count() == 1);
+
+    cout << "Element lifetime tests passed!\n" << endl;
+}
+
+// 构造时可以停住的元素：模拟写入中途被挂起的生产者
+struct Stalling {
+    int value = 0;
+    Stalling() = default;
+    Stalling(int v, atomic<bool>* entered, atomic<bool>* gate) : value(v) {
+        entered->store(true);
+        while (!gate->load())
+            this_thread::yield();
+    }
+};
+
+// 生产者停在元素构造中途：消费者不等待它，照常取走其他元素、在没有其他元素时返回空
+void test_stalled_producer() {
+    cout << "===== Stalled Producer Test =====" << endl;
+    lfq_array_faa<Stalling> queue(4);
+    atomic<bool> entered{ false };
+    atomic<bool> gate{ false };
+
+    thread stalled([&] {
+        bool const ok = queue.emplace(-1, &entered, &gate);
+        assert(ok);
+        });
+    while (!entered.load())
+        this_thread::yield();
+
+    // 停住的生产者占用一个槽位，其余槽位照常使用
+    atomic<bool> open{ true };
+    Stalling out;
+    bool ok;
+    for (int round = 0; round < 10; ++round) {
+        for (int i = 0; i < 3; ++i) {
+            ok = queue.emplace(round * 3 + i, &entered, &open);
+            assert(ok);
+        }
+        ok = queue.emplace(99, &entered, &open);
+        assert(!ok);
+        for (int i = 0; i < 3; ++i) {
+            ok = queue.dequeue(out);
+            assert(ok && out.value == round * 3 + i);
+        }
+        ok = queue.dequeue(out);
+        assert(!ok);
+    }
+
+    // 放行后元素照常出队
+    gate.store(true);
+    stalled.join();
+    ok = queue.dequeue(out);
+    assert(ok && out.value == -1);
+    ok = queue.dequeue(out);
+    assert(!ok);
+
+    cout << "Stalled producer test passed!\n" << endl;
+}
+
+// 多生产者同时写满：不应出现虚假的“已满”
+void test_no_false_full() {
+    cout << "===== No False Full Test =====" << endl;
+    const size_t num_producers = 4;
+    const size_t per_producer = 256;
+    lfq_array_faa<int> queue(num_producers * per_producer);
+
+    atomic<int> failures{ 0 };
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            for (size_t j = 0; j < per_producer; ++j)
+                if (!queue.enqueue(static_cast<int>(i * per_producer + j)))
+                    failures.fetch_add(1, memory_order_relaxed);
+            });
+    }
+    for (auto& p : producers) p.join();
+    assert(failures.load() == 0);
+    bool const ok = queue.enqueue(-1);
+    assert(!ok);
+
+    cout << "No false full test passed!\n" << endl;
+}
+
+// 多生产者多消费者；小容量时消费者频繁越过 tail，触发毒化与 safe 位路径
+void test_mpmc(size_t capacity, size_t num_producers, size_t num_consumers) {
+    cout << "===== MPMC Test (capacity " << capacity << ", " << num_producers << "P/" << num_consumers << "C) =====" << endl;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_faa<int> queue(capacity);
+
+    atomic<size_t> consumed{ 0 };
+    vector<vector<int>> received(num_consumers);
+    vector<thread> threads;
+
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                int item = static_cast<int>(i * items_per_producer + j);
+                while (!queue.enqueue(item))
+                    this_thread::yield();
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            int val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val)) {
+                    received[c].push_back(val);
+                    consumed.fetch_add(1, memory_order_relaxed);
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    // 验证无丢失/重复，且每个消费者看到的同一生产者数据保持顺序
+    vector<bool> seen(total, false);
+    for (auto& items : received) {
+        vector<int> last(num_producers, -1);
+        for (int item : items) {
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+    }
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+    assert(queue.empty());
+
+    // 竞争结束后队列仍可正常使用
+    int val;
+    bool ok = queue.enqueue(42) && queue.dequeue(val);
+    assert(ok && val == 42);
+    ok = queue.dequeue(val);
+    assert(!ok);
+
+    cout << "MPMC test passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_element_lifetime();
+    test_stalled_producer();
+    test_no_false_full();
+    test_mpmc(64, 4, 4);
+    test_mpmc(2, 4, 4);
+    test_mpmc(4, 1, 8);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
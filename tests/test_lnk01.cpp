@@ -0,0 +1,217 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <set>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_linked.h>
+
+using namespace std;
+
+// 队列操作都放在 assert 之外，NDEBUG 下照常执行
+
+// 单线程：哑元头结点下的先进先出，取空后再入队
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    lfq_linked<int> queue(8);
+    assert(queue.empty());
+
+    int val = -1;
+    bool ok = queue.dequeue(val);
+    assert(!ok && val == -1);  // 只有哑元时出队失败，不改动输出
+
+    // 取空后 head_ 与 tail_ 指向同一个哑元，再入队要从这里继续链接
+    for (int round = 0; round < 3; ++round) {
+        ok = queue.enqueue(round);
+        assert(ok);
+        assert(!queue.empty());
+        ok = queue.dequeue(val);
+        assert(ok && val == round);
+        assert(queue.empty());
+    }
+
+    for (int i = 0; i < 1000; ++i) {
+        ok = queue.emplace(i);  // 远超预分配的节点数
+        assert(ok);
+    }
+    for (int i = 0; i < 1000; ++i) {
+        ok = queue.dequeue(val);
+        assert(ok && val == i);
+    }
+    ok = queue.dequeue(val);
+    assert(!ok);
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+struct PoolNode {
+    PoolNode* pool_next = nullptr;
+};
+
+// 节点池：本地缓存后进先出，攒满两块时一块交给共享栈，其他使用者取走而不申请新块
+void test_node_pool() {
+    cout << "===== Node Pool Test =====" << endl;
+    constexpr size_t chunk = 4;
+    lfq_node_pool<PoolNode, chunk> pool;
+    lfq_node_pool<PoolNode, chunk>::cache a, b;
+
+    // 刚归还的节点最先被再次分配
+    PoolNode* n = pool.allocate(a);
+    assert(a.count == chunk - 1);
+    pool.deallocate(a, n);
+    PoolNode* again = pool.allocate(a);
+    assert(again == n);
+    pool.deallocate(a, again);
+
+    // a 再申请一块，归还后本地达到两块，其中一块推入共享栈
+    vector<PoolNode*> taken;
+    for (size_t i = 0; i < 2 * chunk; ++i)
+        taken.push_back(pool.allocate(a));
+    set<PoolNode*> known(taken.begin(), taken.end());
+    assert(known.size() == 2 * chunk);
+    for (PoolNode* p : taken)
+        pool.deallocate(a, p);
+    assert(a.count == chunk);
+
+    // b 从共享栈整体取走这一块：拿到的都是 a 归还的节点
+    for (size_t i = 0; i < chunk; ++i) {
+        PoolNode* p = pool.allocate(b);
+        assert(known.count(p) == 1);
+    }
+    assert(b.count == 0);
+
+    // 共享栈已空，再分配才申请新块
+    PoolNode* fresh = pool.allocate(b);
+    assert(known.count(fresh) == 0);
+
+    cout << "Node pool tests passed!\n" << endl;
+}
+
+struct HazardNode {
+    HazardNode* retired_next = nullptr;
+};
+
+// 风险指针：被公布的节点扫描时保留，撤销公布后的下一次扫描才回收
+void test_hazard_domain() {
+    cout << "===== Hazard Domain Test =====" << endl;
+    lfq_hazard_domain<HazardNode, 2> domain;
+    vector<HazardNode> nodes(200);
+    vector<HazardNode> more(100);
+    vector<int> disposed(nodes.size(), 0);
+    auto dispose = [&](HazardNode* n, lfq_hazard_no_local&) {
+        if (n >= nodes.data() && n < nodes.data() + nodes.size())
+            ++disposed[n - nodes.data()];
+        };
+
+    atomic<HazardNode*> shared{ &nodes[0] };
+    {
+        auto reader = domain.acquire();
+        HazardNode* p = reader.protect(0, shared);
+        assert(p == &nodes[0]);
+
+        // 另一条记录登记全部节点，超过阈值多次扫描
+        {
+            auto writer = domain.acquire();
+            for (auto& node : nodes)
+                writer.retire(&node, dispose);
+        }
+        assert(disposed[0] == 0);
+        assert(count(disposed.begin() + 1, disposed.end(), 1) > 0);
+    }
+
+    // reader 已撤销公布：同一记录继续登记触发扫描，节点0被回收，且每个节点只回收一次
+    {
+        auto writer = domain.acquire();
+        for (auto& node : more)
+            writer.retire(&node, dispose);
+    }
+    assert(disposed[0] == 1);
+    assert(*max_element(disposed.begin(), disposed.end()) == 1);
+
+    cout << "Hazard domain tests passed!\n" << endl;
+}
+
+// 元素只在出队时移出并析构一次；回收的节点在池中循环，剩余元素由析构函数释放
+struct Tracked {
+    static atomic<int> alive;
+    string payload;
+
+    explicit Tracked(string p) : payload(std::move(p)) { alive.fetch_add(1); }
+    Tracked(Tracked&& o) noexcept : payload(std::move(o.payload)) { alive.fetch_add(1); }
+    Tracked& operator=(Tracked&&) noexcept = default;
+    ~Tracked() { alive.fetch_sub(1); }
+};
+atomic<int> Tracked::alive{ 0 };
+
+// 多生产者多消费者：消费者并发摘除哑元并登记回收，节点经扫描回到池中后被生产者复用
+// 消费者移出元素时节点受风险指针保护；ASan/TSan 下运行可发现过早回收
+void test_retire_under_contention(size_t num_producers, size_t num_consumers) {
+    cout << "===== Retire Under Contention Test (" << num_producers << "P/" << num_consumers << "C) =====" << endl;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    const size_t left_over = 100;  // 最后留在队列中的元素
+    {
+        lfq_linked<Tracked> queue(0);
+        atomic<size_t> consumed{ 0 };
+        vector<vector<int>> received(num_consumers);
+        vector<thread> threads;
+
+        for (size_t i = 0; i < num_producers; ++i) {
+            threads.emplace_back([&, i] {
+                for (size_t j = 0; j < items_per_producer; ++j) {
+                    bool const ok = queue.emplace(to_string(i * items_per_producer + j));
+                    assert(ok);
+                }
+                });
+        }
+        for (size_t c = 0; c < num_consumers; ++c) {
+            threads.emplace_back([&, c] {
+                Tracked out("");
+                while (consumed.load(memory_order_relaxed) < total - left_over) {
+                    if (consumed.fetch_add(1, memory_order_relaxed) >= total - left_over) {
+                        break;
+                    }
+                    while (!queue.dequeue(out))
+                        this_thread::yield();
+                    received[c].push_back(stoi(out.payload));
+                }
+                });
+        }
+        for (auto& t : threads) t.join();
+
+        // 无丢失/重复，且每个消费者看到的同一生产者数据保持顺序
+        vector<bool> seen(total, false);
+        size_t count = 0;
+        for (auto& items : received) {
+            vector<int> last(num_producers, -1);
+            for (int item : items) {
+                assert(!seen[item]);
+                seen[item] = true;
+                size_t p = item / items_per_producer;
+                assert(last[p] < item);
+                last[p] = item;
+            }
+            count += items.size();
+        }
+        assert(count == total - left_over);
+        assert(Tracked::alive.load() == static_cast<int>(left_over));
+    }
+    assert(Tracked::alive.load() == 0);
+
+    cout << "Retire under contention test passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_node_pool();
+    test_hazard_domain();
+    test_retire_under_contention(4, 1);
+    test_retire_under_contention(4, 4);
+    test_retire_under_contention(1, 4);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
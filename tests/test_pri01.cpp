@@ -0,0 +1,163 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <stdexcept>
+#include <cassert>
+
+#include <lfq_priority.h>
+
+using namespace std;
+
+// 严格优先级：总是先取高优先级通道，各通道内部保持 FIFO
+void test_strict_priority() {
+    cout << "===== Strict Priority Test =====" << endl;
+    lfq_priority<int, 3> queue(8);
+    assert(queue.levels() == 3);
+    assert(queue.empty());
+
+    int val;
+    assert(!queue.dequeue(val));
+
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.enqueue(2, 200 + i));
+        assert(queue.enqueue(1, 100 + i));
+    }
+    assert(!queue.empty());
+
+    assert(queue.dequeue(val) && val == 100);
+    assert(queue.emplace(0, 1));  // 紧急消息插队
+    assert(queue.dequeue(val) && val == 1);
+
+    for (int i = 1; i < 4; ++i) {
+        assert(queue.dequeue(val) && val == 100 + i);
+    }
+    for (int i = 0; i < 4; ++i) {
+        assert(queue.dequeue(val) && val == 200 + i);
+    }
+    assert(!queue.dequeue(val));
+    assert(queue.empty());
+
+    // 通道取空（清位）后再次入队仍可取出
+    assert(queue.enqueue(1, 7));
+    assert(queue.dequeue(val) && val == 7);
+    assert(!queue.dequeue(val));
+    assert(queue.enqueue(1, 8));
+    assert(queue.dequeue(val) && val == 8);
+
+    // 单个通道满不影响其他通道
+    for (size_t i = 0; i < queue.capacity(); ++i) {
+        assert(queue.enqueue(2, int(i)));
+    }
+    assert(!queue.enqueue(2, -1));
+    assert(queue.enqueue(0, 9));
+    assert(queue.dequeue(val) && val == 9);
+
+    cout << "Strict priority tests passed!\n" << endl;
+}
+
+// 加权轮询：通道 i 每轮连续取 weights[i] 个
+void test_weighted_round_robin() {
+    cout << "===== Weighted Round Robin Test =====" << endl;
+    lfq_priority<int, 3> queue(16, { 3, 2, 1 });
+
+    for (int i = 0; i < 6; ++i) {
+        assert(queue.enqueue(0, 0));
+        assert(queue.enqueue(1, 1));
+        assert(queue.enqueue(2, 2));
+    }
+
+    // 两轮：0 0 0 1 1 2 | 0 0 0 1 1 2
+    vector<int> const expected = { 0, 0, 0, 1, 1, 2, 0, 0, 0, 1, 1, 2 };
+    int val;
+    for (int e : expected) {
+        assert(queue.dequeue(val) && val == e);
+    }
+
+    // 通道0、1耗尽后只剩通道2，不会空转
+    vector<int> rest;
+    while (queue.dequeue(val)) {
+        rest.push_back(val);
+    }
+    assert(rest.size() == 6);
+    assert(rest == vector<int>({ 1, 1, 2, 2, 2, 2 }));
+    assert(queue.empty());
+
+    // 空通道被跳过：只有通道2有数据
+    assert(queue.enqueue(2, 5));
+    assert(queue.dequeue(val) && val == 5);
+
+    cout << "Weighted round robin tests passed!\n" << endl;
+}
+
+// 参数校验
+void test_invalid_arguments() {
+    cout << "===== Invalid Arguments Test =====" << endl;
+    auto throws = [](auto make) {
+        try {
+            make();
+        }
+        catch (const invalid_argument&) {
+            return true;
+        }
+        return false;
+    };
+    assert(throws([] { lfq_priority<int, 2> q(0); }));
+    assert(throws([] { lfq_priority<int, 2> q(4, { 1 }); }));
+    assert(throws([] { lfq_priority<int, 2> q(4, { 1, 0 }); }));
+    cout << "Invalid arguments tests passed!\n" << endl;
+}
+
+// 并发：多个生产者写不同通道，单消费者必须取到全部元素（位图不能丢失置位）
+void test_concurrent(const vector<unsigned>& weights) {
+    cout << "===== Concurrent Test (" << (weights.empty() ? "strict" : "weighted") << ") =====" << endl;
+    constexpr int LEVELS = 4;
+    constexpr int PRODUCERS = 4;
+    constexpr int ITEMS = 20000;
+    lfq_priority<int, LEVELS, lfq_pow2_traits> queue(64, weights);
+
+    vector<thread> producers;
+    for (int p = 0; p < PRODUCERS; ++p) {
+        producers.emplace_back([&queue, p] {
+            for (int i = 0; i < ITEMS; ++i) {
+                // 生产者 p 写通道 p，元素编码为 p * ITEMS + i
+                while (!queue.enqueue(p % LEVELS, p * ITEMS + i)) {
+                    this_thread::yield();
+                }
+            }
+        });
+    }
+
+    vector<int> next(PRODUCERS, 0);
+    int received = 0;
+    int val;
+    while (received < PRODUCERS * ITEMS) {
+        if (!queue.dequeue(val)) {
+            this_thread::yield();
+            continue;
+        }
+        int const p = val / ITEMS;
+        assert(p >= 0 && p < PRODUCERS);
+        assert(val % ITEMS == next[p]);
+        ++next[p];
+        ++received;
+    }
+    for (auto& t : producers) {
+        t.join();
+    }
+    assert(!queue.dequeue(val));
+    assert(queue.empty());
+
+    cout << "Concurrent tests passed!\n" << endl;
+}
+
+int main() {
+    test_strict_priority();
+    test_weighted_round_robin();
+    test_invalid_arguments();
+    test_concurrent({});
+    test_concurrent({ 4, 3, 2, 1 });
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
@@ -0,0 +1,132 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <mutex>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_array_seq.h>
+
+using namespace std;
+
+// 单线程基本功能
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    lfq_array_seq<int> queue(5);  // 取整为8，全部可用
+    assert(queue.capacity() == 8);
+    assert(queue.empty());
+
+    for (int i = 0; i < 8; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(8));
+
+    int val;
+    for (int i = 0; i < 8; ++i)
+        assert(queue.dequeue(val) && val == i);
+    assert(queue.empty());
+    assert(!queue.dequeue(val));
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+// 多生产者同时写满：不应出现虚假的“已满”
+void test_no_false_full() {
+    cout << "===== No False Full Test =====" << endl;
+    const size_t num_producers = 4;
+    const size_t per_producer = 256;
+    lfq_array_seq<int> queue(num_producers * per_producer);
+
+    atomic<int> failures{ 0 };
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            for (size_t j = 0; j < per_producer; ++j)
+                if (!queue.enqueue(static_cast<int>(i * per_producer + j)))
+                    failures.fetch_add(1, memory_order_relaxed);
+            });
+    }
+    for (auto& p : producers) p.join();
+    assert(failures.load() == 0);
+
+    // 生产者与消费者交替推进：队列未满时入队必须成功
+    lfq_array_seq<int> ring(16);
+    thread consumer([&] {
+        int val;
+        for (int n = 0; n < 100000; ++n)
+            while (!ring.dequeue(val))
+                this_thread::yield();
+        });
+    for (int n = 0; n < 100000; ++n)
+        while (!ring.enqueue(n))
+            this_thread::yield();
+    consumer.join();
+    assert(ring.empty());
+
+    cout << "No false full test passed!\n" << endl;
+}
+
+// 多生产者多消费者 (MPMC)
+void test_mpmc() {
+    cout << "===== MPMC Test =====" << endl;
+    const size_t num_producers = 4;
+    const size_t num_consumers = 4;
+    const size_t items_per_producer = 5000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_array_seq<int> queue(64);
+
+    atomic<size_t> consumed{ 0 };
+    vector<vector<int>> received(num_consumers);
+    vector<thread> threads;
+
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                int item = static_cast<int>(i * items_per_producer + j);
+                while (!queue.enqueue(item))
+                    this_thread::yield();
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            int val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val)) {
+                    received[c].push_back(val);
+                    consumed.fetch_add(1, memory_order_relaxed);
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    // 验证无丢失/重复，且每个消费者看到的同一生产者数据保持顺序
+    vector<bool> seen(total, false);
+    for (auto& items : received) {
+        vector<int> last(num_producers, -1);
+        for (int item : items) {
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+    }
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+    assert(queue.empty());
+
+    cout << "MPMC test passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_no_false_full();
+    test_mpmc();
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
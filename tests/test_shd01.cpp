@@ -0,0 +1,168 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <stdexcept>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_sharded.h>
+
+using namespace std;
+
+// 显式 token：各自的分片、轮询出队
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    lfq_sharded<int, lfq_pow2_traits> queue(4, 4);
+    assert(queue.capacity() == 4);
+    assert(queue.empty());
+
+    int val;
+    assert(!queue.dequeue(val));
+    {
+        lfq_sharded<int, lfq_pow2_traits>::producer_token a(queue);
+        lfq_sharded<int, lfq_pow2_traits>::producer_token b(queue);
+        for (int i = 0; i < 4; ++i) {
+            assert(queue.enqueue(a, 100 + i));
+            assert(queue.emplace(b, 200 + i));
+        }
+        assert(!queue.enqueue(a, 999));  // 分片已满，不影响其他分片
+
+        // drain_batch 为1：两个分片交替，各自保持 FIFO
+        for (int i = 0; i < 4; ++i) {
+            assert(queue.dequeue(val) && val == 100 + i);
+            assert(queue.dequeue(val) && val == 200 + i);
+        }
+        assert(queue.empty());
+        assert(!queue.dequeue(val));
+
+        // token 归还前元素仍可取出
+        assert(queue.enqueue(a, 1));
+    }
+    assert(queue.dequeue(val) && val == 1);
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+// 分片认领：超出上限时抛异常，归还后可再次认领
+void test_token_limit() {
+    cout << "===== Token Limit Test =====" << endl;
+    lfq_sharded<int> queue(8, 2);
+    {
+        lfq_sharded<int>::producer_token a(queue);
+        lfq_sharded<int>::producer_token b(queue);
+        bool thrown = false;
+        try {
+            lfq_sharded<int>::producer_token c(queue);
+        }
+        catch (const runtime_error&) {
+            thrown = true;
+        }
+        assert(thrown);
+    }
+    lfq_sharded<int>::producer_token c(queue);
+    assert(queue.enqueue(c, 7));
+
+    // 隐式 token 的线程退出后归还分片
+    for (int round = 0; round < 4; ++round) {
+        thread t([&] { assert(queue.enqueue(round)); });
+        t.join();
+    }
+    int val;
+    assert(queue.dequeue(val) && val == 7);
+    for (int round = 0; round < 4; ++round)
+        assert(queue.dequeue(val) && val == round);
+
+    cout << "Token limit test passed!\n" << endl;
+}
+
+// 批量轮询：每个分片连续取 drain_batch 个
+void test_drain_batch() {
+    cout << "===== Drain Batch Test =====" << endl;
+    lfq_sharded<int> queue(64, 4, 3);
+    lfq_sharded<int>::producer_token a(queue);
+    lfq_sharded<int>::producer_token b(queue);
+    for (int i = 0; i < 6; ++i) {
+        assert(queue.enqueue(a, 10 + i));
+        assert(queue.enqueue(b, 20 + i));
+    }
+
+    int val;
+    vector<int> order;
+    for (int i = 0; i < 6; ++i) {
+        assert(queue.dequeue(val));
+        order.push_back(val);
+    }
+    assert((order == vector<int>{ 10, 11, 12, 20, 21, 22 }));
+
+    int out[16];
+    assert(queue.dequeue_bulk(out, 16) == 6);
+    assert((vector<int>(out, out + 6) == vector<int>{ 13, 14, 15, 23, 24, 25 }));
+    assert(queue.dequeue_bulk(out, 16) == 0);
+
+    cout << "Drain batch test passed!\n" << endl;
+}
+
+// 多生产者：显式与隐式 token，单消费者验证每个生产者的 FIFO
+void test_multi_producer(bool implicit) {
+    cout << "===== Multi Producer Test (" << (implicit ? "implicit" : "token") << ") =====" << endl;
+    const size_t num_producers = 4;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    lfq_sharded<int> queue(128, num_producers);
+
+    vector<thread> producers;
+    for (size_t i = 0; i < num_producers; ++i) {
+        producers.emplace_back([&, i] {
+            if (implicit) {
+                for (size_t j = 0; j < items_per_producer; ++j)
+                    while (!queue.enqueue(static_cast<int>(i * items_per_producer + j)))
+                        this_thread::yield();
+            }
+            else {
+                lfq_sharded<int>::producer_token token(queue);
+                for (size_t j = 0; j < items_per_producer; ++j)
+                    while (!queue.enqueue(token, static_cast<int>(i * items_per_producer + j)))
+                        this_thread::yield();
+            }
+            });
+    }
+
+    vector<int> last(num_producers, -1);
+    vector<bool> seen(total, false);
+    int buf[32];
+    for (size_t got = 0; got < total;) {
+        size_t n = queue.dequeue_bulk(buf, 32);
+        if (n == 0 && queue.dequeue(buf[0]))
+            n = 1;
+        if (n == 0) {
+            this_thread::yield();
+            continue;
+        }
+        for (size_t k = 0; k < n; ++k) {
+            int item = buf[k];
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+        got += n;
+    }
+    for (auto& p : producers) p.join();
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+    assert(queue.empty());
+
+    cout << "Multi producer test passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_token_limit();
+    test_drain_batch();
+    test_multi_producer(false);
+    test_multi_producer(true);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
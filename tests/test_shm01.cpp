@@ -0,0 +1,341 @@
+#include <iostream>
+#include <fstream>
+#include <vector>
+#include <string>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <type_traits>
+#include <cstdint>
+#include <stdexcept>
+#include <system_error>
+#include <cassert>
+
+#include <sys/wait.h>
+#include <unistd.h>
+
+#include <lfq_shm.h>
+
+using namespace std;
+
+struct Message {
+    uint32_t producer;
+    uint32_t seq;
+    uint64_t checksum;
+};
+
+static uint64_t checksum_of(uint32_t producer, uint32_t seq) {
+    return (static_cast<uint64_t>(producer) << 32 | seq) * 0x9E3779B97F4A7C15ull;
+}
+
+static string unique_name(const char* tag) {
+    return string("/lfq_shm_test_") + tag + "_" + to_string(getpid());
+}
+
+// 等待子进程并确认其正常退出
+static void wait_children(const vector<pid_t>& pids) {
+    for (pid_t pid : pids) {
+        int status = 0;
+        assert(waitpid(pid, &status, 0) == pid);
+        assert(WIFEXITED(status) && WEXITSTATUS(status) == 0);
+    }
+}
+
+// 具名创建/连接：同一进程内两个映射共享状态
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    string const name = unique_name("basic");
+    auto a = lfq_shm<int>::create(name, 6);
+    assert(a.capacity() == 8);  // 向上取整为2的幂
+    assert(a.empty());
+
+    auto b = lfq_shm<int>::attach(name);
+    assert(b.capacity() == 8);
+
+    // 队列操作放在 assert 之外，NDEBUG 下照常执行
+    int val;
+    bool ok = b.dequeue(val);
+    assert(!ok);
+    for (int i = 0; i < 8; ++i) {
+        ok = a.enqueue(i);
+        assert(ok);
+    }
+    ok = a.enqueue(99);
+    assert(!ok);  // 已满
+    assert(!b.empty());
+
+    for (int i = 0; i < 8; ++i) {
+        ok = b.dequeue(val);
+        assert(ok && val == i);
+    }
+    assert(a.empty());
+    ok = a.dequeue(val);
+    assert(!ok);
+
+    // 回绕后仍保持 FIFO
+    for (int round = 0; round < 5; ++round) {
+        ok = b.emplace(round);
+        assert(ok);
+        ok = a.dequeue(val);
+        assert(ok && val == round);
+    }
+
+    // 名字已存在时创建失败
+    bool thrown = false;
+    try {
+        lfq_shm<int>::create(name, 8);
+    }
+    catch (const system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 删除名字后无法再连接，已有映射仍然可用
+    lfq_shm<int>::unlink(name);
+    thrown = false;
+    try {
+        lfq_shm<int>::attach(name);
+    }
+    catch (const system_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+    ok = a.enqueue(7) && b.dequeue(val);
+    assert(ok && val == 7);
+
+    // 移动后由新对象持有映射
+    lfq_shm<int> c = std::move(a);
+    ok = c.enqueue(8) && b.dequeue(val);
+    assert(ok && val == 8);
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+// 本进程当前的映射个数（Linux），用于检查失败路径是否解除了映射
+size_t mapping_count() {
+    ifstream maps("/proc/self/maps");
+    size_t n = 0;
+    string line;
+    while (getline(maps, line))
+        ++n;
+    return n;
+}
+
+// 参数与布局校验
+void test_validation() {
+    cout << "===== Validation Test =====" << endl;
+    bool thrown = false;
+    try {
+        lfq_shm<int>::create(unique_name("zero"), 0);
+    }
+    catch (const invalid_argument&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 元素类型不一致时拒绝连接
+    string const name = unique_name("layout");
+    auto q = lfq_shm<int>::create(name, 16);
+    thrown = false;
+    try {
+        lfq_shm<Message>::attach(name);
+    }
+    catch (const runtime_error&) {
+        thrown = true;
+    }
+    assert(thrown);
+
+    // 校验失败时不留下映射
+#if defined(__linux__)
+    size_t const before = mapping_count();
+    for (int i = 0; i < 50; ++i) {
+        try {
+            lfq_shm<Message>::attach(name);
+            assert(false);
+        }
+        catch (const runtime_error&) {
+        }
+    }
+    assert(mapping_count() == before);
+#endif
+    lfq_shm<int>::unlink(name);
+
+    cout << "Validation tests passed!\n" << endl;
+}
+
+// 构造时可以停住或退出的元素，仍可平凡复制：用来让生产者停在认领槽位之后、发布之前
+struct Stalling {
+    int value;
+
+    Stalling() = default;
+    Stalling(int v, atomic<bool>* entered, atomic<bool>* gate) : value(v) {
+        entered->store(true);
+        while (!gate->load())
+            this_thread::yield();
+    }
+    Stalling(int v, int exit_code) : value(v) { _exit(exit_code); }
+    explicit Stalling(int v) : value(v) {}
+};
+
+// 生产者认领后未发布：dequeue 立即返回 false，不等待对端；dequeue_wait 等待到超时或发布
+void test_stalled_producer() {
+    cout << "===== Stalled Producer Test =====" << endl;
+    static_assert(is_trivially_copyable<Stalling>::value, "Stalling must stay trivially copyable.");
+    auto queue = lfq_shm<Stalling>::create_anonymous(8);
+    auto peer = lfq_shm<Stalling>::attach_fd(queue.fd());  // 另一份映射，地址不同
+
+    // 1. 本进程内的线程停在构造中
+    atomic<bool> entered{ false };
+    atomic<bool> gate{ false };
+    thread stalled([&] {
+        bool const ok = peer.emplace(1, &entered, &gate);
+        assert(ok);
+        });
+    while (!entered.load())
+        this_thread::yield();
+
+    bool ok = queue.enqueue(Stalling(2));  // 排在停住的元素之后
+    assert(ok);
+    Stalling out(0);
+    ok = queue.dequeue(out);
+    assert(!ok);
+    auto begin = chrono::steady_clock::now();
+    ok = queue.dequeue_wait(out, chrono::milliseconds(20));
+    assert(!ok);
+    assert(chrono::steady_clock::now() - begin >= chrono::milliseconds(20));
+
+    gate.store(true);
+    stalled.join();
+    ok = queue.dequeue_wait(out, chrono::seconds(5));
+    assert(ok && out.value == 1);
+    ok = queue.dequeue(out);
+    assert(ok && out.value == 2);
+
+    // 2. 子进程认领槽位后退出：该位置永久占用，但父进程的出队照常返回
+    pid_t const pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        peer.emplace(3, 0);  // 构造中 _exit(0)
+        _exit(1);
+    }
+    wait_children({ pid });
+    ok = queue.enqueue(Stalling(4));
+    assert(ok);
+    for (int i = 0; i < 100; ++i) {
+        ok = queue.dequeue(out);
+        assert(!ok);
+    }
+    ok = queue.dequeue_wait(out, chrono::milliseconds(10));
+    assert(!ok);
+
+    cout << "Stalled producer tests passed!\n" << endl;
+}
+
+// 多个子进程作为生产者（fork 继承匿名映射），父进程消费
+void test_fork_producers() {
+    cout << "===== Fork Producers Test =====" << endl;
+    constexpr uint32_t PRODUCERS = 3;
+    constexpr uint32_t ITEMS = 20000;
+    auto queue = lfq_shm<Message>::create_anonymous(64);
+
+    vector<pid_t> pids;
+    for (uint32_t p = 0; p < PRODUCERS; ++p) {
+        pid_t const pid = fork();
+        assert(pid >= 0);
+        if (pid == 0) {
+            for (uint32_t i = 0; i < ITEMS; ++i) {
+                Message const msg{ p, i, checksum_of(p, i) };
+                while (!queue.enqueue(msg)) {
+                    sched_yield();
+                }
+            }
+            _exit(0);
+        }
+        pids.push_back(pid);
+    }
+
+    // 每个生产者的元素按序到达且内容完整
+    vector<uint32_t> next(PRODUCERS, 0);
+    uint64_t received = 0;
+    Message msg;
+    while (received < uint64_t(PRODUCERS) * ITEMS) {
+        if (!queue.dequeue(msg)) {
+            sched_yield();
+            continue;
+        }
+        assert(msg.producer < PRODUCERS);
+        assert(msg.seq == next[msg.producer]);
+        assert(msg.checksum == checksum_of(msg.producer, msg.seq));
+        ++next[msg.producer];
+        ++received;
+    }
+    wait_children(pids);
+    assert(queue.empty());
+
+    cout << "Fork producers tests passed!\n" << endl;
+}
+
+// 子进程按名字重新连接（映射地址不同），父子双向收发
+void test_attach_by_name() {
+    cout << "===== Attach By Name Test =====" << endl;
+    constexpr uint32_t ITEMS = 10000;
+    string const request_name = unique_name("req");
+    string const reply_name = unique_name("rep");
+    auto requests = lfq_shm<Message>::create(request_name, 32);
+    auto replies = lfq_shm<Message>::create(reply_name, 32);
+
+    pid_t const pid = fork();
+    assert(pid >= 0);
+    if (pid == 0) {
+        // 子进程：回显请求，checksum 加一
+        auto req = lfq_shm<Message>::attach(request_name);
+        auto rep = lfq_shm<Message>::attach(reply_name);
+        Message msg;
+        for (uint32_t i = 0; i < ITEMS; ++i) {
+            while (!req.dequeue(msg)) {
+                sched_yield();
+            }
+            if (msg.seq != i || msg.checksum != checksum_of(0, i))
+                _exit(1);
+            msg.checksum += 1;
+            while (!rep.enqueue(msg)) {
+                sched_yield();
+            }
+        }
+        _exit(0);
+    }
+
+    uint32_t sent = 0;
+    uint32_t received = 0;
+    Message msg;
+    while (received < ITEMS) {
+        if (sent < ITEMS && requests.enqueue(Message{ 0, sent, checksum_of(0, sent) })) {
+            ++sent;
+        }
+        if (replies.dequeue(msg)) {
+            assert(msg.seq == received);
+            assert(msg.checksum == checksum_of(0, received) + 1);
+            ++received;
+        }
+        else if (sent == ITEMS) {
+            sched_yield();
+        }
+    }
+    wait_children({ pid });
+    lfq_shm<Message>::unlink(request_name);
+    lfq_shm<Message>::unlink(reply_name);
+
+    cout << "Attach by name tests passed!\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_validation();
+#if defined(__linux__)
+    test_stalled_producer();
+#endif
+    test_fork_producers();
+    test_attach_by_name();
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
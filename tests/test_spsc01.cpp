@@ -0,0 +1,80 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <string>
+#include <cassert>
+
+#include <lfq_spsc.h>
+
+using namespace std;
+
+// 单线程基本功能
+void test_basic_functionality() {
+    cout << "===== SPSC Basic Functionality Test =====" << endl;
+    lfq_spsc<int> queue(5);
+
+    assert(queue.empty());
+    assert(queue.enqueue(1));
+    assert(queue.enqueue(2));
+    assert(!queue.empty());
+
+    int val;
+    assert(queue.dequeue(val) && val == 1);
+    assert(queue.dequeue(val) && val == 2);
+    assert(queue.empty());
+    assert(!queue.dequeue(val));
+
+    // 与 lfq_array_based 一致：容量5实际可用4
+    for (int i = 0; i < 4; ++i)
+        assert(queue.enqueue(i));
+    assert(!queue.enqueue(10));
+
+    // 2的幂模式全部可用
+    lfq_spsc<int, lfq_pow2_traits> pow2(5);
+    assert(pow2.capacity() == 8);
+    for (int i = 0; i < 8; ++i)
+        assert(pow2.enqueue(i));
+    assert(!pow2.enqueue(8));
+    for (int i = 0; i < 8; ++i)
+        assert(pow2.dequeue(val) && val == i);
+
+    cout << "SPSC basic tests passed!\n" << endl;
+}
+
+// 单生产者单消费者并发：顺序严格一致
+template <typename Traits>
+void test_spsc(const char* name, size_t capacity) {
+    cout << "===== SPSC Concurrent Test: " << name << " cap=" << capacity << " =====" << endl;
+    const int total = 100000;
+    lfq_spsc<string, Traits> queue(capacity);
+
+    thread producer([&] {
+        for (int i = 0; i < total; ++i) {
+            string item = to_string(i);
+            while (!queue.enqueue(std::move(item)))
+                this_thread::yield();
+        }
+        });
+
+    string val;
+    for (int i = 0; i < total; ++i) {
+        while (!queue.dequeue(val))
+            this_thread::yield();
+        assert(val == to_string(i));
+    }
+    producer.join();
+    assert(queue.empty());
+
+    cout << "Passed!\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_spsc<lfq_default_traits>("modulo", 2);
+    test_spsc<lfq_default_traits>("modulo", 100);
+    test_spsc<lfq_pow2_traits>("pow2", 1);
+    test_spsc<lfq_pow2_traits>("pow2", 1024);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
@@ -0,0 +1,590 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <chrono>
+#include <random>
+#include <string>
+#include <cstdint>
+#include <cstdio>
+#include <cstdlib>
+#include <algorithm>
+#include <type_traits>
+
+#include <lfq_array_based.h>
+#include <lfq_array_seq.h>
+#include <lfq_array_faa.h>
+#include <lfq_spsc.h>
+#include <lfq_unbounded.h>
+#include <lfq_linked.h>
+#include <lfq_sharded.h>
+#include <lfq_priority.h>
+#include <lfq_broadcast.h>
+
+using namespace std;
+
+// 随机压力测试：随机的生产者/消费者个数、容量、元素个数与批量大小，每个引擎反复运行直到时间用完
+// 每轮校验：
+//   每个元素恰好被取出一次，同一消费者看到的同一生产者的元素保持 FIFO
+//   单消费者时，已确认发布但尚未取出的元素存在时 empty() 必须为 false
+//   元素的构造/析构成对出现（队列析构时释放剩余元素），不会使用已析构的对象
+// 提供 enqueue_wait/dequeue_wait/close 的队列另随机选用两种模式：
+//   阻塞：只用等待接口（随机带超时），生产者全部结束后 close()，消费者取空后退出
+//   等待中关闭：随机时刻 close()，阻塞在满/空上的线程必须全部返回；关闭前成功入队的元素恰好取出一次
+// 广播队列单独校验：每个消费者恰好看到每个元素一次，依赖的消费者总是先处理完
+// 用法：test_stress01 [秒数] [种子]，默认2秒、随机种子；失败时按打印的种子复现
+// 检查不依赖 assert，Release（NDEBUG）构建同样生效
+
+uint64_t stress_seed = 0;                  // 命令行种子
+atomic<uint64_t> stress_case_seed{ 0 };    // 当前用例的种子
+
+[[noreturn]] void stress_fail(const char* expr, const char* file, int line) {
+    fprintf(stderr, "Check failed: %s (%s:%d), seed %llu, case seed %llu\n", expr, file, line,
+        static_cast<unsigned long long>(stress_seed),
+        static_cast<unsigned long long>(stress_case_seed.load()));
+    abort();
+}
+
+#define STRESS_CHECK(cond) ((cond) ? (void)0 : stress_fail(#cond, __FILE__, __LINE__))
+
+// 带生命周期计数的元素
+struct tracked {
+    static constexpr uint64_t alive_tag = 0xA11CE5A11CE5A11Cull;
+    static constexpr uint64_t dead_tag = 0xDEADDEADDEADDEADull;
+    static atomic<long> live;
+
+    uint32_t producer = 0;
+    uint32_t seq = 0;
+    uint64_t tag = alive_tag;
+
+    tracked() { live.fetch_add(1, memory_order_relaxed); }
+
+    tracked(uint32_t p, uint32_t s) : producer(p), seq(s) { live.fetch_add(1, memory_order_relaxed); }
+
+    tracked(const tracked& other) : producer(other.producer), seq(other.seq) {
+        STRESS_CHECK(other.tag == alive_tag);
+        live.fetch_add(1, memory_order_relaxed);
+    }
+
+    tracked(tracked&& other) noexcept : producer(other.producer), seq(other.seq) {
+        STRESS_CHECK(other.tag == alive_tag);
+        live.fetch_add(1, memory_order_relaxed);
+    }
+
+    tracked& operator=(const tracked& other) {
+        STRESS_CHECK(tag == alive_tag && other.tag == alive_tag);
+        producer = other.producer;
+        seq = other.seq;
+        return *this;
+    }
+
+    tracked& operator=(tracked&& other) noexcept {
+        STRESS_CHECK(tag == alive_tag && other.tag == alive_tag);
+        producer = other.producer;
+        seq = other.seq;
+        return *this;
+    }
+
+    ~tracked() {
+        STRESS_CHECK(tag == alive_tag);  // 重复析构
+        tag = dead_tag;
+        live.fetch_sub(1, memory_order_relaxed);
+    }
+};
+
+atomic<long> tracked::live{ 0 };
+
+// 是否提供批量接口
+template <typename Q, typename = void>
+struct has_enqueue_bulk : false_type {};
+template <typename Q>
+struct has_enqueue_bulk<Q, void_t<decltype(declval<Q&>().enqueue_bulk(declval<tracked*>(), size_t()))>> : true_type {};
+
+template <typename Q, typename = void>
+struct has_dequeue_bulk : false_type {};
+template <typename Q>
+struct has_dequeue_bulk<Q, void_t<decltype(declval<Q&>().dequeue_bulk(declval<tracked*>(), size_t()))>> : true_type {};
+
+// 是否提供等待接口与 close()
+template <typename Q, typename = void>
+struct has_wait : false_type {};
+template <typename Q>
+struct has_wait<Q, void_t<decltype(declval<Q&>().enqueue_wait(declval<tracked&&>())),
+    decltype(declval<Q&>().dequeue_wait(declval<tracked&>())),
+    decltype(declval<Q&>().close())>> : true_type {};
+
+enum class stress_mode {
+    try_ops,        // 只用 try 接口
+    blocking,       // 等待接口，生产者结束后关闭
+    close_waiting,  // 等待接口，随机时刻关闭
+};
+
+struct stress_case {
+    size_t producers;
+    size_t consumers;
+    size_t capacity;
+    size_t items;    // 每个生产者的元素数
+    size_t batch;    // 批量接口每次的最大个数，1 为逐个
+    stress_mode mode;
+    uint64_t seed;
+};
+
+// 偶尔让出时间片，增加线程交错
+struct jitter {
+    minstd_rand rng;
+    explicit jitter(uint64_t seed) : rng(static_cast<uint32_t>(seed) | 1u) {}
+    size_t below(size_t n) { return rng() % n; }
+    void maybe_yield() {
+        if ((rng() & 63) == 0)
+            this_thread::yield();
+    }
+};
+
+// 一个消费者视角下的校验：元素存活、编号合法、逐生产者 FIFO、全局恰好一次
+struct receiver {
+    const stress_case& c;
+    vector<atomic<uint8_t>>& seen;
+    vector<int64_t> last;
+    size_t count = 0;
+
+    receiver(const stress_case& cs, vector<atomic<uint8_t>>& s) : c(cs), seen(s), last(cs.producers, -1) {}
+
+    void accept(const tracked& t) {
+        STRESS_CHECK(t.tag == tracked::alive_tag);
+        STRESS_CHECK(t.producer < c.producers && t.seq < c.items);
+        STRESS_CHECK(static_cast<int64_t>(t.seq) > last[t.producer]);  // 逐生产者 FIFO
+        last[t.producer] = t.seq;
+        uint8_t const before = seen[t.producer * c.items + t.seq].fetch_add(1, memory_order_relaxed);
+        STRESS_CHECK(before == 0);  // 恰好一次
+        ++count;
+    }
+};
+
+// 等待中关闭：生产者用 enqueue_wait 直到被关闭拒绝，消费者用 dequeue_wait 直到关闭且取空
+template <typename Queue>
+void run_close_case(const stress_case& c) {
+    long const baseline = tracked::live.load();
+    {
+        Queue queue(c.capacity);
+        vector<atomic<uint8_t>> seen(c.producers * c.items);
+        for (auto& s : seen) s.store(0, memory_order_relaxed);
+        vector<size_t> sent(c.producers, 0);  // 每个生产者成功入队的个数（编号 0..sent-1）
+
+        vector<thread> threads;
+        for (size_t p = 0; p < c.producers; ++p) {
+            threads.emplace_back([&, p] {
+                jitter rng(c.seed * 31 + p);
+                for (size_t i = 0; i < c.items; ++i) {
+                    tracked t(static_cast<uint32_t>(p), static_cast<uint32_t>(i));
+                    bool ok = false;
+                    while (!ok) {
+                        // 失败时 t 不会被移动，可以继续使用
+                        ok = rng.below(2) ? queue.enqueue_wait(std::move(t))
+                            : queue.enqueue_wait(std::move(t), chrono::microseconds(rng.below(200)));
+                        if (!ok && queue.is_closed())
+                            return;
+                    }
+                    sent[p] = i + 1;
+                    rng.maybe_yield();
+                }
+                });
+        }
+
+        vector<receiver> receivers;
+        receivers.reserve(c.consumers + 1);
+        for (size_t cidx = 0; cidx < c.consumers; ++cidx)
+            receivers.emplace_back(c, seen);
+        for (size_t cidx = 0; cidx < c.consumers; ++cidx) {
+            threads.emplace_back([&, cidx] {
+                jitter rng(c.seed * 37 + 1000 + cidx);
+                tracked t;
+                for (;;) {
+                    bool const ok = rng.below(2) ? queue.dequeue_wait(t)
+                        : queue.dequeue_wait(t, chrono::microseconds(rng.below(300)));
+                    if (ok) {
+                        receivers[cidx].accept(t);
+                    }
+                    else if (queue.is_closed()) {
+                        // 不带超时的 dequeue_wait 只在关闭且取空后返回 false
+                        while (queue.dequeue_wait(t))
+                            receivers[cidx].accept(t);
+                        break;
+                    }
+                    rng.maybe_yield();
+                }
+                });
+        }
+
+        // 随机时刻关闭：可能在开始之前、生产途中或全部生产完之后
+        jitter closer(c.seed * 41);
+        this_thread::sleep_for(chrono::microseconds(closer.below(3000)));
+        queue.close();
+        for (auto& t : threads) t.join();
+
+        // 关闭之后的入队一律失败
+        STRESS_CHECK(!queue.enqueue(tracked(0, 0)));
+
+        // 与 close() 并发而成功的入队可能晚于消费者退出，由这里取走
+        receivers.emplace_back(c, seen);
+        {
+            tracked t;
+            while (queue.dequeue(t))
+                receivers.back().accept(t);
+        }
+        for (size_t p = 0; p < c.producers; ++p) {
+            for (size_t i = 0; i < c.items; ++i)
+                STRESS_CHECK(seen[p * c.items + i].load() == (i < sent[p] ? 1 : 0));
+        }
+        STRESS_CHECK(queue.empty());
+    }
+    STRESS_CHECK(tracked::live.load() == baseline);
+}
+
+template <typename Queue>
+void run_case(const stress_case& c) {
+    constexpr bool waitable = has_wait<Queue>::value;
+    if constexpr (waitable) {
+        if (c.mode == stress_mode::close_waiting) {
+            run_close_case<Queue>(c);
+            return;
+        }
+    }
+    bool const blocking = waitable && c.mode == stress_mode::blocking;
+
+    long const baseline = tracked::live.load();
+    size_t const total = c.producers * c.items;
+    {
+        Queue queue(c.capacity);
+        vector<atomic<uint8_t>> seen(total);
+        for (auto& s : seen) s.store(0, memory_order_relaxed);
+        vector<atomic<size_t>> published(c.producers);  // 每个生产者已确认入队的个数
+        for (auto& p : published) p.store(0, memory_order_relaxed);
+        atomic<size_t> consumed{ 0 };
+
+        vector<thread> threads;
+        for (size_t p = 0; p < c.producers; ++p) {
+            threads.emplace_back([&, p] {
+                jitter rng(c.seed * 31 + p);
+                size_t i = 0;
+                vector<tracked> buf;
+                while (i < c.items) {
+                    size_t n = 1;
+                    bool ok = false;
+                    if constexpr (waitable) {
+                        if (blocking) {
+                            tracked t(static_cast<uint32_t>(p), static_cast<uint32_t>(i));
+                            ok = rng.below(2) ? queue.enqueue_wait(std::move(t))
+                                : queue.enqueue_wait(std::move(t), chrono::microseconds(rng.below(200)));
+                            n = ok ? 1 : 0;
+                        }
+                    }
+                    if constexpr (has_enqueue_bulk<Queue>::value) {
+                        if (!blocking && c.batch > 1)
+                            n = min({ 1 + rng.below(c.batch), c.items - i, queue.capacity() });
+                        if (!blocking && n > 1) {
+                            buf.clear();
+                            for (size_t k = 0; k < n; ++k)
+                                buf.emplace_back(static_cast<uint32_t>(p), static_cast<uint32_t>(i + k));
+                            ok = queue.enqueue_bulk(buf.data(), n);
+                        }
+                    }
+                    if (!blocking && n == 1) {
+                        ok = queue.enqueue(tracked(static_cast<uint32_t>(p), static_cast<uint32_t>(i)));
+                    }
+                    if (ok) {
+                        i += n;
+                        published[p].store(i, memory_order_release);
+                    }
+                    else if (!blocking) {
+                        this_thread::yield();
+                    }
+                    rng.maybe_yield();
+                }
+                });
+        }
+
+        for (size_t cidx = 0; cidx < c.consumers; ++cidx) {
+            threads.emplace_back([&, cidx] {
+                jitter rng(c.seed * 37 + 1000 + cidx);
+                receiver r(c, seen);
+                vector<tracked> buf(c.batch);
+                auto accept = [&](const tracked& t) {
+                    r.accept(t);
+                    consumed.fetch_add(1, memory_order_relaxed);
+                };
+
+                if constexpr (waitable) {
+                    // 阻塞模式：等待接口随机带超时，关闭后取空即退出
+                    if (blocking) {
+                        tracked t;
+                        for (;;) {
+                            bool const ok = rng.below(2) ? queue.dequeue_wait(t)
+                                : queue.dequeue_wait(t, chrono::microseconds(rng.below(300)));
+                            if (ok) {
+                                accept(t);
+                            }
+                            else if (queue.is_closed()) {
+                                while (queue.dequeue_wait(t))
+                                    accept(t);
+                                return;
+                            }
+                            rng.maybe_yield();
+                        }
+                    }
+                }
+
+                while (consumed.load(memory_order_relaxed) < total) {
+                    // 单消费者：先读取已确认发布的个数，多于已取出的个数时队列不可能为空
+                    size_t confirmed = 0;
+                    if (c.consumers == 1) {
+                        for (auto& p : published)
+                            confirmed += p.load(memory_order_acquire);
+                    }
+
+                    size_t got = 0;
+                    if constexpr (has_dequeue_bulk<Queue>::value) {
+                        if (c.batch > 1) {
+                            got = queue.dequeue_bulk(buf.data(), 1 + rng.below(c.batch));
+                            for (size_t k = 0; k < got; ++k)
+                                accept(buf[k]);
+                        }
+                    }
+                    if (c.batch <= 1 || !has_dequeue_bulk<Queue>::value) {
+                        tracked t;
+                        if (queue.dequeue(t)) {
+                            accept(t);
+                            got = 1;
+                        }
+                    }
+
+                    if (got == 0) {
+                        if (c.consumers == 1 && confirmed > r.count)
+                            STRESS_CHECK(!queue.empty());
+                        this_thread::yield();
+                    }
+                    rng.maybe_yield();
+                }
+                });
+        }
+
+        // 阻塞模式下生产者全部结束后关闭，唤醒等待中的消费者
+        for (size_t i = 0; i < c.producers; ++i)
+            threads[i].join();
+        if constexpr (waitable) {
+            if (blocking)
+                queue.close();
+        }
+        for (size_t i = c.producers; i < threads.size(); ++i)
+            threads[i].join();
+
+        STRESS_CHECK(consumed.load() == total);
+        for (auto& s : seen) STRESS_CHECK(s.load() == 1);
+        STRESS_CHECK(queue.empty());
+        {
+            tracked t;
+            STRESS_CHECK(!queue.dequeue(t));
+        }
+        STRESS_CHECK(tracked::live.load() == baseline);
+
+        // 留下一些元素，由队列析构时释放（已关闭时入队失败）
+        size_t const leftover = min<size_t>(c.capacity, 1 + c.seed % 7);
+        for (size_t i = 0; i < leftover; ++i)
+            queue.enqueue(tracked(0, static_cast<uint32_t>(i)));
+    }
+    STRESS_CHECK(tracked::live.load() == baseline);
+}
+
+// 多优先级队列：生产者 p 固定写入通道 p % levels，单消费者看到的同一生产者元素保持 FIFO
+template <bool Weighted>
+class priority_adapter {
+public:
+    static constexpr size_t levels = 3;
+
+    explicit priority_adapter(size_t capacity)
+        : queue_(capacity, Weighted ? vector<unsigned>{ 4, 2, 1 } : vector<unsigned>{}) {}
+
+    bool enqueue(tracked&& value) { return queue_.enqueue(value.producer % levels, std::move(value)); }
+
+    bool dequeue(tracked& value) { return queue_.dequeue(value); }
+
+    bool empty() const { return queue_.empty(); }
+
+    size_t capacity() const { return queue_.capacity(); }
+
+private:
+    lfq_priority<tracked, levels> queue_;
+};
+
+// 广播队列：c.consumers 个读者，随机依赖此前注册的读者；每个读者恰好看到每个元素一次
+void run_broadcast_case(const stress_case& c) {
+    long const baseline = tracked::live.load();
+    size_t const total = c.producers * c.items;
+    {
+        lfq_broadcast<tracked> queue(c.capacity);
+        jitter setup(c.seed * 43);
+        vector<vector<size_t>> deps(c.consumers);
+        for (size_t r = 0; r < c.consumers; ++r) {
+            size_t const kind = r == 0 ? 0 : setup.below(3);
+            size_t id = 0;
+            if (kind == 0) {
+                id = queue.add_consumer();
+            }
+            else if (kind == 1) {
+                deps[r] = { setup.below(r) };
+                id = queue.add_consumer({ deps[r][0] });
+            }
+            else {
+                deps[r] = { setup.below(r), setup.below(r) };
+                id = queue.add_consumer({ deps[r][0], deps[r][1] });
+            }
+            STRESS_CHECK(id == r);
+        }
+
+        vector<atomic<uint8_t>> seen(c.consumers * total);
+        for (auto& s : seen) s.store(0, memory_order_relaxed);
+
+        vector<thread> threads;
+        for (size_t p = 0; p < c.producers; ++p) {
+            threads.emplace_back([&, p] {
+                jitter rng(c.seed * 31 + p);
+                for (size_t i = 0; i < c.items; ++i) {
+                    while (!queue.enqueue(tracked(static_cast<uint32_t>(p), static_cast<uint32_t>(i))))
+                        this_thread::yield();
+                    rng.maybe_yield();
+                }
+                });
+        }
+        for (size_t r = 0; r < c.consumers; ++r) {
+            threads.emplace_back([&, r] {
+                jitter rng(c.seed * 37 + 1000 + r);
+                vector<int64_t> last(c.producers, -1);
+                size_t processed = 0;
+                auto handle = [&](const tracked& t) {
+                    STRESS_CHECK(t.tag == tracked::alive_tag);
+                    STRESS_CHECK(t.producer < c.producers && t.seq < c.items);
+                    STRESS_CHECK(static_cast<int64_t>(t.seq) > last[t.producer]);  // 逐生产者 FIFO
+                    last[t.producer] = t.seq;
+                    size_t const item = t.producer * c.items + t.seq;
+                    for (size_t up : deps[r])
+                        STRESS_CHECK(seen[up * total + item].load(memory_order_relaxed) == 1);  // 上游先处理完
+                    STRESS_CHECK(seen[r * total + item].fetch_add(1, memory_order_relaxed) == 0);  // 恰好一次
+                    ++processed;
+                };
+
+                tracked t;
+                while (processed < total) {
+                    size_t got = 0;
+                    if (rng.below(2)) {
+                        got = queue.consume(r, handle, 1 + rng.below(16));
+                    }
+                    else if (queue.dequeue(r, t)) {
+                        handle(t);
+                        got = 1;
+                    }
+                    if (got == 0)
+                        this_thread::yield();
+                    rng.maybe_yield();
+                }
+                STRESS_CHECK(queue.empty(r));
+                });
+        }
+        for (auto& t : threads) t.join();
+
+        for (auto& s : seen) STRESS_CHECK(s.load() == 1);
+
+        // 槽位中保留的元素与新入队的元素由队列析构时释放
+        size_t const leftover = min<size_t>(c.capacity, 1 + c.seed % 7);
+        for (size_t i = 0; i < leftover; ++i)
+            queue.enqueue(tracked(0, static_cast<uint32_t>(i)));
+    }
+    STRESS_CHECK(tracked::live.load() == baseline);
+}
+
+struct stress_engine {
+    const char* name;
+    bool multi_producer;
+    bool multi_consumer;
+    void (*run)(const stress_case&);
+};
+
+template <typename T>
+using lfq_array_mpmc = lfq_array_based<T, lfq_mpmc_traits>;
+
+struct remap_traits : lfq_pow2_traits {
+    using slot_layout = lfq_remap_layout;
+};
+
+struct batch_head_traits : lfq_pow2_traits {
+    static constexpr size_t head_publish_interval = 4;
+};
+
+struct backoff_mpmc_traits : lfq_mpmc_traits {
+    using backoff_policy = lfq_adaptive_backoff<>;
+};
+
+// 挂起等待：覆盖 futex 唤醒与关闭时的唤醒
+struct park_traits : lfq_default_traits {
+    using wait_strategy = lfq_park_wait<>;
+};
+
+struct park_mpmc_traits : lfq_mpmc_traits {
+    using wait_strategy = lfq_park_wait<>;
+};
+
+int main(int argc, char** argv) {
+    double seconds = 2.0;
+    if (argc > 1)
+        seconds = atof(argv[1]);
+    uint64_t seed = argc > 2 ? strtoull(argv[2], nullptr, 10) : random_device{}();
+    stress_seed = seed;
+    cout << "Stress test: " << seconds << "s, seed " << seed << endl;
+
+    vector<stress_engine> engines = {
+        { "array_based", true, false, &run_case<lfq_array_based<tracked>> },
+        { "array_pow2", true, false, &run_case<lfq_array_based<tracked, lfq_pow2_traits>> },
+        { "array_remap", true, false, &run_case<lfq_array_based<tracked, remap_traits>> },
+        { "array_batchhead", true, false, &run_case<lfq_array_based<tracked, batch_head_traits>> },
+        { "array_park", true, false, &run_case<lfq_array_based<tracked, park_traits>> },
+        { "array_mpmc", true, true, &run_case<lfq_array_mpmc<tracked>> },
+        { "array_mpmc_backoff", true, true, &run_case<lfq_array_based<tracked, backoff_mpmc_traits>> },
+        { "array_mpmc_park", true, true, &run_case<lfq_array_based<tracked, park_mpmc_traits>> },
+        { "array_seq", true, true, &run_case<lfq_array_seq<tracked>> },
+        { "array_faa", true, true, &run_case<lfq_array_faa<tracked>> },
+        { "spsc", false, false, &run_case<lfq_spsc<tracked>> },
+        { "unbounded", true, false, &run_case<lfq_unbounded<tracked, 8>> },
+        { "unbounded_mpmc", true, true, &run_case<lfq_unbounded<tracked, 8, lfq_mpmc_traits>> },
+        { "linked", true, true, &run_case<lfq_linked<tracked>> },
+        { "sharded", true, false, &run_case<lfq_sharded<tracked>> },
+        { "priority", true, false, &run_case<priority_adapter<false>> },
+        { "priority_weighted", true, false, &run_case<priority_adapter<true>> },
+        { "broadcast", true, true, &run_broadcast_case },
+    };
+
+    mt19937_64 rng(seed);
+    auto pick = [&](size_t lo, size_t hi) { return uniform_int_distribution<size_t>(lo, hi)(rng); };
+    auto const budget = chrono::duration<double>(seconds / engines.size());
+
+    for (auto& e : engines) {
+        cout << "===== " << e.name << " =====" << endl;
+        auto const deadline = chrono::steady_clock::now() + budget;
+        size_t cases = 0;
+        do {
+            stress_case c;
+            c.producers = e.multi_producer ? pick(1, 6) : 1;
+            c.consumers = e.multi_consumer ? pick(1, 4) : 1;
+            c.capacity = size_t(1) << pick(1, 10);  // 取模索引保留一个空槽，容量至少为2
+            c.capacity += pick(0, 1) ? pick(0, c.capacity) : 0;  // 一半为非2的幂
+            c.items = pick(100, 4000);
+            c.batch = pick(0, 2) ? 1 : pick(2, 16);
+            c.mode = static_cast<stress_mode>(pick(0, 2));  // 不支持等待接口的队列总是 try_ops
+            c.seed = rng();
+            stress_case_seed.store(c.seed);
+            e.run(c);
+            ++cases;
+        } while (chrono::steady_clock::now() < deadline);
+        cout << e.name << ": " << cases << " cases passed\n" << endl;
+    }
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}
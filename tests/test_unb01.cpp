@@ -0,0 +1,217 @@
+#include <iostream>
+#include <vector>
+#include <thread>
+#include <atomic>
+#include <string>
+#include <cassert>
+#include <algorithm>
+
+#include <lfq_unbounded.h>
+
+using namespace std;
+
+// 单线程：跨越多个段的先进先出，入队从不失败
+void test_basic_functionality() {
+    cout << "===== Basic Functionality Test =====" << endl;
+    lfq_unbounded<int, 4> queue(8);
+    assert(queue.empty());
+
+    // 队列操作放在 assert 之外，NDEBUG 下照常执行
+    int val;
+    bool ok = queue.dequeue(val);
+    assert(!ok);
+    for (int i = 0; i < 1000; ++i) {
+        ok = queue.enqueue(i);  // 远超预分配容量
+        assert(ok);
+    }
+    assert(!queue.empty());
+    for (int i = 0; i < 1000; ++i) {
+        ok = queue.dequeue(val);
+        assert(ok && val == i);
+    }
+    assert(queue.empty());
+    ok = queue.dequeue(val);
+    assert(!ok);
+
+    // 反复的突发：段被回收后复用
+    for (int round = 0; round < 50; ++round) {
+        for (int i = 0; i < 37; ++i) {
+            ok = queue.emplace(round * 100 + i);
+            assert(ok);
+        }
+        for (int i = 0; i < 37; ++i) {
+            ok = queue.dequeue(val);
+            assert(ok && val == round * 100 + i);
+        }
+        assert(queue.empty());
+    }
+
+    cout << "Basic tests passed!\n" << endl;
+}
+
+// 元素生命周期：跨段剩余的元素由析构函数释放
+struct Counted {
+    static atomic<int> alive;
+    string payload;
+
+    explicit Counted(string p) : payload(std::move(p)) { alive.fetch_add(1); }
+    Counted(const Counted& o) : payload(o.payload) { alive.fetch_add(1); }
+    Counted(Counted&& o) noexcept : payload(std::move(o.payload)) { alive.fetch_add(1); }
+    Counted& operator=(Counted&&) noexcept = default;
+    ~Counted() { alive.fetch_sub(1); }
+};
+atomic<int> Counted::alive{ 0 };
+
+void test_lifetime() {
+    cout << "===== Lifetime Test =====" << endl;
+    {
+        lfq_unbounded<Counted, 8> queue;
+        for (int i = 0; i < 50; ++i) {
+            bool const ok = queue.emplace(to_string(i));
+            assert(ok);
+        }
+        Counted out("");
+        for (int i = 0; i < 21; ++i) {
+            bool const ok = queue.dequeue(out);
+            assert(ok && out.payload == to_string(i));
+        }
+        assert(Counted::alive.load() == 29 + 1);
+    }
+    assert(Counted::alive.load() == 0);
+    cout << "Lifetime test passed!\n" << endl;
+}
+
+// 纪元登记记录：线程首次访问时认领并一直持有，退出后供其他线程复用
+// 元素构造时再访问同一队列（嵌套进入）改用临时记录
+struct Reentrant;
+lfq_unbounded<Reentrant, 4>* reentrant_queue = nullptr;
+struct Reentrant {
+    int value = 0;
+    Reentrant() = default;
+    explicit Reentrant(int v) : value(v) { reentrant_queue->empty(); }
+};
+
+void test_epoch_records() {
+    cout << "===== Epoch Records Test =====" << endl;
+    {
+        lfq_unbounded<Reentrant, 4> queue;
+        reentrant_queue = &queue;
+        for (int i = 0; i < 100; ++i) {
+            bool const ok = queue.emplace(i);
+            assert(ok);
+        }
+        Reentrant out;
+        for (int i = 0; i < 100; ++i) {
+            bool const ok = queue.dequeue(out);
+            assert(ok && out.value == i);
+        }
+        assert(queue.empty());
+        reentrant_queue = nullptr;
+    }
+
+    // 大量短命线程：记录在线程退出时归还，段照常回收
+    lfq_unbounded<int, 4> queue;
+    for (int round = 0; round < 200; ++round) {
+        thread([&, round] {
+            for (int i = 0; i < 10; ++i) {
+                bool const ok = queue.enqueue(round * 10 + i);
+                assert(ok);
+            }
+            }).join();
+    }
+    int val;
+    for (int i = 0; i < 2000; ++i) {
+        bool const ok = queue.dequeue(val);
+        assert(ok && val == i);
+    }
+    assert(queue.empty());
+
+    // 线程比队列活得久：队列析构后记录仍由线程持有，不会悬空
+    atomic<int> stage{ 0 };
+    thread worker([&] {
+        {
+            lfq_unbounded<int, 4> local;
+            for (int i = 0; i < 20; ++i) {
+                bool const ok = local.enqueue(i) && local.dequeue(val);
+                assert(ok);
+            }
+        }
+        stage.store(1);
+        while (stage.load() != 2)
+            this_thread::yield();
+        lfq_unbounded<int, 4> next;  // 可能复用同一个缓存下标
+        bool const ok = next.enqueue(1) && next.dequeue(val);
+        assert(ok && val == 1);
+        });
+    while (stage.load() != 1)
+        this_thread::yield();
+    stage.store(2);
+    worker.join();
+
+    cout << "Epoch records test passed!\n" << endl;
+}
+
+// 多生产者多消费者：小段频繁追加与回收
+template <typename Queue>
+void test_concurrent(const char* name, size_t num_producers, size_t num_consumers) {
+    cout << "===== Concurrent Test: " << name << " =====" << endl;
+    const size_t items_per_producer = 20000;
+    const size_t total = num_producers * items_per_producer;
+    Queue queue(0);
+
+    atomic<size_t> consumed{ 0 };
+    vector<vector<int>> received(num_consumers);
+    vector<thread> threads;
+
+    for (size_t i = 0; i < num_producers; ++i) {
+        threads.emplace_back([&, i] {
+            for (size_t j = 0; j < items_per_producer; ++j) {
+                bool const ok = queue.enqueue(static_cast<int>(i * items_per_producer + j));
+                assert(ok);
+            }
+            });
+    }
+    for (size_t c = 0; c < num_consumers; ++c) {
+        threads.emplace_back([&, c] {
+            int val;
+            while (consumed.load(memory_order_relaxed) < total) {
+                if (queue.dequeue(val)) {
+                    received[c].push_back(val);
+                    consumed.fetch_add(1, memory_order_relaxed);
+                }
+                else {
+                    this_thread::yield();
+                }
+            }
+            });
+    }
+    for (auto& t : threads) t.join();
+
+    // 验证无丢失/重复，且每个消费者看到的同一生产者数据保持顺序
+    vector<bool> seen(total, false);
+    for (auto& items : received) {
+        vector<int> last(num_producers, -1);
+        for (int item : items) {
+            assert(!seen[item]);
+            seen[item] = true;
+            size_t p = item / items_per_producer;
+            assert(last[p] < item);
+            last[p] = item;
+        }
+    }
+    assert(find(seen.begin(), seen.end(), false) == seen.end());
+    assert(queue.empty());
+
+    cout << "Concurrent test passed! Items: " << total << "\n" << endl;
+}
+
+int main() {
+    test_basic_functionality();
+    test_lifetime();
+    test_epoch_records();
+    test_concurrent<lfq_unbounded<int, 16>>("mpsc", 4, 1);
+    test_concurrent<lfq_unbounded<int, 16, lfq_mpmc_traits>>("mpmc", 4, 4);
+
+    cout << "All tests passed successfully!" << endl;
+    return 0;
+}